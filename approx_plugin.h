@@ -0,0 +1,77 @@
+#ifndef APPROX_PLUGIN_H
+#define APPROX_PLUGIN_H
+
+/* C interface for loading approximations from shared libraries at runtime, so kernels can be built outside of approx
+ * with their own compiler and flags. A plugin exports the function approx_plugin() returning a list of kernels.
+ * Every kernel names the test suite (the -f function name, e.g. "sqrtf") it is run in together with the built-in
+ * approximations. The input and output types of the kernel must match the ones of the suite.
+ * Load plugins with "approx -f sqrtf --plugin ./libmysqrt.so". See plugin_example.c and plugin.h.
+ * See: https://man7.org/linux/man-pages/man3/dlopen.3.html */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Increased on incompatible changes. approx refuses to load plugins built with another version. */
+#define APPROX_PLUGIN_ABI_VERSION 1
+
+/* Name of the function a plugin must export */
+#define APPROX_PLUGIN_ENTRY_NAME "approx_plugin"
+
+#if defined(_WIN32)
+#define APPROX_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define APPROX_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+/* Input and output value types */
+typedef enum ApproxType
+{
+    APPROX_TYPE_FLOAT = 1,
+    APPROX_TYPE_DOUBLE = 2,
+    APPROX_TYPE_INT16 = 3,
+    APPROX_TYPE_UINT16 = 4,
+    APPROX_TYPE_INT32 = 5,
+    APPROX_TYPE_UINT32 = 6,
+    APPROX_TYPE_INT64 = 7,
+    APPROX_TYPE_UINT64 = 8
+} ApproxType;
+
+/* Generic function pointer. Cast scalar functions to this type, approx casts them back using the types of the kernel. */
+typedef void (*ApproxFunction)(void);
+
+/* Batch function processing count values from x to y. x and y point to arrays of the kernel's input and output type. */
+typedef void (*ApproxBatchFunction)(const void* x, void* y, size_t count);
+
+typedef struct ApproxKernel
+{
+    const char* suite; /* test suite to run the kernel in, e.g. "sqrtf" */
+    const char* name; /* short name, e.g. "#fast". approx prefixes it with the file name of the plugin */
+    const char* description; /* description of the method, e.g. "Magic constant + 1x Newton". If NULL, the description of
+                                the built-in approximation with the same name is used */
+    ApproxType inputType; /* type of the input value */
+    ApproxType outputType; /* type of the output value */
+    ApproxFunction scalar; /* function of type output(input), e.g. float (*)(float). Can be NULL if batch is set */
+    ApproxBatchFunction batch; /* batch version. Can be NULL if scalar is set. If both are set, both are tested */
+    double validMin; /* smallest input value the kernel is made for. Ignored if validMin >= validMax */
+    double validMax; /* largest input value the kernel is made for */
+} ApproxKernel;
+
+typedef struct ApproxPlugin
+{
+    uint32_t abiVersion; /* set to APPROX_PLUGIN_ABI_VERSION */
+    size_t kernelCount; /* number of kernels */
+    const ApproxKernel* kernels; /* kernels. Must stay valid until the plugin is unloaded */
+} ApproxPlugin;
+
+/* Type of the function exported as APPROX_PLUGIN_ENTRY_NAME */
+typedef const ApproxPlugin* (*ApproxPluginEntry)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+// Bit manipulation helpers used by integer approximations and for handling floating-point bit patterns.
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// @brief Count leading zero bits of an unsigned integer of up to 64 bits.
+/// The result for x == 0 is undefined, like for __builtin_clz.
+template <typename T>
+inline int countLeadingZeros(T x)
+{
+    static_assert(std::is_unsigned<T>::value && std::numeric_limits<T>::digits <= 64, "Only unsigned types up to 64 bits supported");
+    constexpr int digits = std::numeric_limits<T>::digits;
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, static_cast<uint64_t>(x));
+    return digits - 1 - static_cast<int>(index);
+#else
+    if constexpr (digits <= 32)
+    {
+        return __builtin_clz(static_cast<uint32_t>(x)) - (32 - digits);
+    }
+    else
+    {
+        return __builtin_clzll(static_cast<uint64_t>(x));
+    }
+#endif
+}
+
+/// @brief Number of bits needed to represent x, e.g. 0 for 0, 1 for 1, 3 for 5.
+template <typename T>
+inline int bitLength(T x)
+{
+    return x == 0 ? 0 : std::numeric_limits<T>::digits - countLeadingZeros(x);
+}
+
+/// @brief Map a float or double to an unsigned integer that sorts in IEEE 754 total order, so
+/// -NaN < -inf < ... < -0 < 0 < ... < inf < NaN. Unlike comparing values this works for NaN and -0
+/// and is not affected by the CPU treating denormals as zero (DAZ), which -ffast-math enables.
+template <typename T>
+inline auto totalOrderBits(T x)
+{
+    static_assert(std::is_floating_point<T>::value && (sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t)), "Only float and double supported");
+    using U = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    U u;
+    std::memcpy(&u, &x, sizeof(u));
+    // flip all bits of negative values and only the sign bit of positive values
+    constexpr U signBit = U(1) << (std::numeric_limits<U>::digits - 1);
+    return (u & signBit) ? U(~u) : U(u | signBit);
+}
+
+/// @brief Convert the result of totalOrderBits() back to a float or double value.
+template <typename T, typename U>
+inline T fromTotalOrderBits(U key)
+{
+    static_assert(sizeof(T) == sizeof(U), "Type sizes must match");
+    constexpr U signBit = U(1) << (std::numeric_limits<U>::digits - 1);
+    const U u = (key & signBit) ? U(key & ~signBit) : U(~key);
+    T x;
+    std::memcpy(&x, &u, sizeof(x));
+    return x;
+}
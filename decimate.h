@@ -0,0 +1,95 @@
+#pragma once
+
+// Reduce curves with many samples to the points that are visible in a plot of a given width.
+// Keeping the minimum and maximum per pixel column preserves spikes, unlike taking every n-th value.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+/// @brief Returns true if x is finite and can be drawn. Checks the bits, because -ffast-math assumes there are no NaNs and inf.
+inline bool isDrawable(const double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return ((bits >> 52) & 0x7FF) != 0x7FF;
+}
+
+/// @brief Get the smallest and largest drawable x value.
+/// @return false if there are no drawable values.
+template <typename X>
+bool drawableRange(const std::vector<X>& xValues, std::pair<double, double>& range)
+{
+    bool found = false;
+    for (const auto& v : xValues)
+    {
+        const double x = double(v);
+        if (isDrawable(x))
+        {
+            range = found ? std::make_pair(std::min(range.first, x), std::max(range.second, x)) : std::make_pair(x, x);
+            found = true;
+        }
+    }
+    return found;
+}
+
+/// @brief Reduce a curve to the minimum and maximum value of each of columns pixel columns, so the plot looks the same,
+/// but the number of points does not depend on the number of samples. The points are sorted by x first, so the input
+/// values can be in any order and have any spacing, e.g. random or logarithmic. Points with a non-finite x are dropped.
+/// @param xValues Input value of every point.
+/// @param values Value of every point.
+template <typename X, typename T>
+void decimate(const std::vector<X>& xValues, const std::vector<T>& values, std::size_t columns, std::vector<double>& x, std::vector<double>& y)
+{
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < xValues.size(); ++i)
+    {
+        if (isDrawable(double(xValues[i])))
+        {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&xValues](std::size_t a, std::size_t b)
+                     { return double(xValues[a]) < double(xValues[b]); });
+    const std::size_t n = order.size();
+    auto add = [&](std::size_t i)
+    {
+        x.push_back(double(xValues[i]));
+        y.push_back(double(values[i]));
+    };
+    if (n <= 2 * columns)
+    {
+        for (const auto i : order)
+        {
+            add(i);
+        }
+        return;
+    }
+    const double xFirst = double(xValues[order.front()]);
+    const double xWidth = double(xValues[order.back()]) - xFirst;
+    auto column = [&](std::size_t i)
+    {
+        return xWidth > 0 ? std::min(columns - 1, std::size_t((double(xValues[i]) - xFirst) / xWidth * double(columns))) : 0;
+    };
+    for (std::size_t first = 0; first < n;)
+    {
+        // the points in the same pixel column as the first one
+        std::size_t last = first + 1;
+        while (last < n && column(order[last]) == column(order[first]))
+        {
+            ++last;
+        }
+        const auto mme = std::minmax_element(order.cbegin() + first, order.cbegin() + last, [&values](std::size_t a, std::size_t b)
+                                             { return values[a] < values[b]; });
+        // keep the order of the points, so the curve does not jump back
+        add(*std::min(mme.first, mme.second));
+        if (mme.first != mme.second)
+        {
+            add(*std::max(mme.first, mme.second));
+        }
+        first = last;
+    }
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+// 16-bit floating-point types for testing half precision / bfloat16 approximations.
+// float16 is an IEEE 754 binary16 number (1 sign, 5 exponent, 10 mantissa bits).
+// bfloat16 is the upper half of an IEEE 754 binary32 float (1 sign, 8 exponent, 7 mantissa bits).
+// Both are software-emulated storage types. They convert implicitly from and to float, so all arithmetic is done in float.
+// half_t uses the compiler's _Float16 type if available, which uses F16C / AVX512-FP16 instructions where the CPU supports them.
+// See: https://en.wikipedia.org/wiki/Half-precision_floating-point_format
+// See: https://en.wikipedia.org/wiki/Bfloat16_floating-point_format
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+struct float16
+{
+    uint16_t bits;
+
+    float16() = default;
+
+    float16(float f)
+        : bits(fromFloat(f))
+    {
+    }
+
+    operator float() const
+    {
+        return toFloat(bits);
+    }
+
+    static uint16_t fromFloat(float f)
+    {
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        const uint16_t sign = static_cast<uint16_t>((u >> 16) & 0x8000);
+        const uint32_t absU = u & 0x7FFFFFFF;
+        if (absU >= 0x7F800000)
+        {
+            // infinity or NaN. keep NaN a quiet NaN
+            return sign | (absU > 0x7F800000 ? 0x7E00 : 0x7C00);
+        }
+        if (absU >= 0x477FF000)
+        {
+            // >= 65520 rounds to infinity
+            return sign | 0x7C00;
+        }
+        if (absU < 0x38800000)
+        {
+            // subnormal result. add 0.5 as float to let the FPU do the rounding and shift the mantissa bits to the bottom
+            float a;
+            std::memcpy(&a, &absU, sizeof(a));
+            a += 0.5F;
+            uint32_t r;
+            std::memcpy(&r, &a, sizeof(r));
+            return sign | static_cast<uint16_t>(r - 0x3F000000);
+        }
+        // normal result. re-bias the exponent and round to nearest even
+        const uint32_t odd = (absU >> 13) & 1;
+        return sign | static_cast<uint16_t>((absU - ((127 - 15) << 23) + 0xFFF + odd) >> 13);
+    }
+
+    static float toFloat(uint16_t h)
+    {
+        const uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+        const uint32_t absH = h & 0x7FFF;
+        uint32_t u;
+        if (absH >= 0x7C00)
+        {
+            // infinity or NaN
+            u = sign | 0x7F800000 | ((absH & 0x03FF) << 13);
+        }
+        else if (absH < 0x0400)
+        {
+            // zero or subnormal. the mantissa is an integer times 2^-24
+            float f = static_cast<float>(absH) * (1.0F / 16777216.0F);
+            std::memcpy(&u, &f, sizeof(u));
+            u |= sign;
+        }
+        else
+        {
+            u = sign | ((absH << 13) + ((127 - 15) << 23));
+        }
+        float f;
+        std::memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+};
+
+struct bfloat16
+{
+    uint16_t bits;
+
+    bfloat16() = default;
+
+    bfloat16(float f)
+        : bits(fromFloat(f))
+    {
+    }
+
+    operator float() const
+    {
+        return toFloat(bits);
+    }
+
+    static uint16_t fromFloat(float f)
+    {
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        if ((u & 0x7FFFFFFF) > 0x7F800000)
+        {
+            // NaN. make sure it stays a NaN when truncating the mantissa
+            return static_cast<uint16_t>((u >> 16) | 0x0040);
+        }
+        // round to nearest even
+        return static_cast<uint16_t>((u + 0x7FFF + ((u >> 16) & 1)) >> 16);
+    }
+
+    static float toFloat(uint16_t b)
+    {
+        const uint32_t u = static_cast<uint32_t>(b) << 16;
+        float f;
+        std::memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+};
+
+#if defined(__FLT16_MANT_DIG__)
+using half_t = _Float16;
+#else
+using half_t = float16;
+#endif
+
+/// @brief Properties of the 16-bit floating-point formats needed for bit manipulation.
+template <typename T>
+struct Float16Traits;
+
+template <>
+struct Float16Traits<float16>
+{
+    static constexpr int MantissaBits = 10;
+    static constexpr int ExponentBias = 15;
+    static constexpr const char* Name = "fp16";
+};
+
+#if defined(__FLT16_MANT_DIG__)
+template <>
+struct Float16Traits<_Float16> : Float16Traits<float16>
+{
+};
+#endif
+
+template <>
+struct Float16Traits<bfloat16>
+{
+    static constexpr int MantissaBits = 7;
+    static constexpr int ExponentBias = 127;
+    static constexpr const char* Name = "bf16";
+};
+
+/// @brief Get the bit pattern of a 16-bit floating-point value.
+template <typename T>
+inline uint16_t toBits(const T x)
+{
+    static_assert(sizeof(T) == sizeof(uint16_t), "Only 16-bit types supported");
+    uint16_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+/// @brief Create a 16-bit floating-point value from a bit pattern.
+template <typename T>
+inline T fromBits(const uint16_t bits)
+{
+    static_assert(sizeof(T) == sizeof(uint16_t), "Only 16-bit types supported");
+    T x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+#if defined(__FLT16_MANT_DIG__)
+inline std::ostream& operator<<(std::ostream& os, const _Float16 x)
+{
+    return os << static_cast<float>(x);
+}
+#endif
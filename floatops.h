@@ -0,0 +1,276 @@
+#pragma once
+
+// Building blocks for float approximations of exponential, logarithmic and related functions.
+// Arguments are reduced using the exponent bits of the float and the remaining part is approximated with a polynomial.
+// Every block exists for float and, with AVX2 + FMA, for __m256 (8 floats) with the same name,
+// so a kernel can be written once as a template and used for scalar and batch versions.
+// See: https://en.wikipedia.org/wiki/Horner%27s_method
+// See: Jean-Michel Muller, "Elementary Functions: Algorithms and Implementation", chapter 11 (range reduction)
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+// == ln(2)
+#define LN2_F 0.6931471805599453F
+// == 1 / ln(2)
+#define LOG2E_F 1.4426950408889634F
+
+/// @brief Polynomial coefficients c1, c2, ..., cN for p(x) = c1 * x + c2 * x^2 + ... + cN * x^N.
+/// The constant term is not part of the array, because it is handled by the function (0 for log2, 1 for exp2).
+template <std::size_t N>
+using Coefficients = std::array<float, N>;
+
+/// @brief Create a value with all elements set to c.
+template <typename V>
+inline V broadcast(const float c);
+
+template <>
+inline float broadcast<float>(const float c)
+{
+    return c;
+}
+
+/// @brief Calculate a + b.
+inline float add(const float a, const float b)
+{
+    return a + b;
+}
+
+/// @brief Calculate a - b.
+inline float subtract(const float a, const float b)
+{
+    return a - b;
+}
+
+/// @brief Calculate a * b.
+inline float multiply(const float a, const float b)
+{
+    return a * b;
+}
+
+/// @brief Calculate a / b.
+inline float divide(const float a, const float b)
+{
+    return a / b;
+}
+
+/// @brief Calculate a * b + c. Compiles to an FMA instruction if available.
+inline float multiplyAdd(const float a, const float b, const float c)
+{
+    return a * b + c;
+}
+
+/// @brief Limit x to [lo, hi].
+inline float clamp(const float x, const float lo, const float hi)
+{
+    return std::min(std::max(x, lo), hi);
+}
+
+/// @brief Calculate |x| by clearing the sign bit.
+inline float absolute(const float x)
+{
+    return std::fabs(x);
+}
+
+/// @brief Return the magnitude of x with the sign of s.
+inline float copySign(const float x, const float s)
+{
+    return std::copysign(x, s);
+}
+
+/// @brief Split x into exponent e and mantissa m, so x = m * 2^e with m in [sqrt(0.5), sqrt(2)).
+/// Centering the mantissa around 1 makes log2(m) symmetric, which needs a lower polynomial degree than m in [1, 2).
+/// Subtracting the bits of sqrt(0.5) moves the exponent up by one for mantissas >= sqrt(2).
+/// Only works for positive normal values. Returns m - 1 and the exponent as float.
+inline float splitMantissa(const float x, float& exponent)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const int32_t e = static_cast<int32_t>(bits - 0x3F3504F3) >> 23;
+    bits -= static_cast<uint32_t>(e) << 23;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    exponent = static_cast<float>(e);
+    return m - 1.0F;
+}
+
+/// @brief Split x into integer n and fraction f, so x = n + f with f in [-0.5, 0.5].
+/// Returns f and 2^n, which is created by putting n into the exponent bits.
+/// Only works if 2^n is a normal float value, so x must be in [-126, 128).
+inline float splitInteger(const float x, float& pow2)
+{
+    // lrint rounds to nearest and compiles to a single instruction (cvtss2si) with -fno-math-errno
+    const int32_t n = static_cast<int32_t>(std::lrint(x));
+    const uint32_t bits = static_cast<uint32_t>(n + 127) << 23;
+    std::memcpy(&pow2, &bits, sizeof(pow2));
+    return x - static_cast<float>(n);
+}
+
+/// @brief Calculate x * pow2 for pow2 = 2^n from splitInteger() by adding n to the exponent bits of x.
+/// Unlike a float multiplication, -ffast-math can not distribute it over the sum x was calculated from, where a
+/// small term times 2^n can be flushed to zero. Only works if x and the result are normal float values.
+inline float multiplyPow2(const float x, const float pow2)
+{
+    uint32_t bits;
+    uint32_t pow2Bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    std::memcpy(&pow2Bits, &pow2, sizeof(pow2Bits));
+    bits += pow2Bits - (127U << 23);
+    float r;
+    std::memcpy(&r, &bits, sizeof(r));
+    return r;
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+template <>
+inline __m256 broadcast<__m256>(const float c)
+{
+    return _mm256_set1_ps(c);
+}
+
+inline __m256 add(const __m256 a, const __m256 b)
+{
+    return _mm256_add_ps(a, b);
+}
+
+inline __m256 subtract(const __m256 a, const __m256 b)
+{
+    return _mm256_sub_ps(a, b);
+}
+
+inline __m256 multiply(const __m256 a, const __m256 b)
+{
+    return _mm256_mul_ps(a, b);
+}
+
+inline __m256 divide(const __m256 a, const __m256 b)
+{
+    return _mm256_div_ps(a, b);
+}
+
+inline __m256 multiplyAdd(const __m256 a, const __m256 b, const __m256 c)
+{
+    return _mm256_fmadd_ps(a, b, c);
+}
+
+inline __m256 clamp(const __m256 x, const float lo, const float hi)
+{
+    return _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(lo)), _mm256_set1_ps(hi));
+}
+
+inline __m256 absolute(const __m256 x)
+{
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0F), x);
+}
+
+inline __m256 copySign(const __m256 x, const __m256 s)
+{
+    const __m256 signBit = _mm256_set1_ps(-0.0F);
+    return _mm256_or_ps(_mm256_andnot_ps(signBit, x), _mm256_and_ps(signBit, s));
+}
+
+inline __m256 splitMantissa(const __m256 x, __m256& exponent)
+{
+    const __m256i bits = _mm256_castps_si256(x);
+    const __m256i e = _mm256_srai_epi32(_mm256_sub_epi32(bits, _mm256_set1_epi32(0x3F3504F3)), 23);
+    const __m256 m = _mm256_castsi256_ps(_mm256_sub_epi32(bits, _mm256_slli_epi32(e, 23)));
+    exponent = _mm256_cvtepi32_ps(e);
+    return _mm256_sub_ps(m, _mm256_set1_ps(1.0F));
+}
+
+inline __m256 splitInteger(const __m256 x, __m256& pow2)
+{
+    // cvtps2dq rounds to nearest using the default rounding mode
+    const __m256i n = _mm256_cvtps_epi32(x);
+    pow2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23));
+    return _mm256_sub_ps(x, _mm256_cvtepi32_ps(n));
+}
+
+inline __m256 multiplyPow2(const __m256 x, const __m256 pow2)
+{
+    const __m256i exponent = _mm256_sub_epi32(_mm256_castps_si256(pow2), _mm256_set1_epi32(127 << 23));
+    return _mm256_castsi256_ps(_mm256_add_epi32(_mm256_castps_si256(x), exponent));
+}
+#endif
+
+/// @brief Evaluate p(x) = c1 * x + c2 * x^2 + ... + cN * x^N using Horner's method.
+/// Returns c1 + c2 * x + ... + cN * x^(N-1), so the caller can add the constant term with one more multiply-add.
+template <std::size_t N, typename V>
+inline V evaluatePolynomial(const V x, const Coefficients<N>& c)
+{
+    static_assert(N > 0, "At least one coefficient needed");
+    V r = broadcast<V>(c[N - 1]);
+    for (std::size_t i = N - 1; i > 0; --i)
+    {
+        r = multiplyAdd(r, x, broadcast<V>(c[i - 1]));
+    }
+    return r;
+}
+
+/// @brief log2(x) = e + log2(m) = e + p(m - 1). See splitMantissa().
+template <std::size_t N, typename V>
+inline V log2Polynomial(const V x, const Coefficients<N>& c)
+{
+    V e;
+    const V f = splitMantissa(x, e);
+    return multiplyAdd(f, evaluatePolynomial(f, c), e);
+}
+
+/// @brief 2^x = 2^n * 2^f = 2^n * (1 + p(f)). See splitInteger() and multiplyPow2().
+template <std::size_t N, typename V>
+inline V exp2Polynomial(const V x, const Coefficients<N>& c)
+{
+    V pow2;
+    const V f = splitInteger(x, pow2);
+    return multiplyPow2(multiplyAdd(f, evaluatePolynomial(f, c), broadcast<V>(1.0F)), pow2);
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+/// @brief Apply a kernel written for float and __m256 to an array, 8 values at a time.
+/// The remaining values are calculated using the scalar version.
+template <typename Kernel>
+inline void transformBatch(const float* x, float* y, std::size_t count, Kernel kernel)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(y + i, kernel(_mm256_loadu_ps(x + i)));
+    }
+    for (; i < count; ++i)
+    {
+        y[i] = kernel(x[i]);
+    }
+}
+
+/// @brief Apply a kernel with two arguments written for float and __m256 to an array of tuples, 8 values at a time.
+/// The memory layout of std::tuple is implementation-defined, so the elements are copied to two arrays first.
+template <typename Kernel>
+inline void transformBatch(const std::tuple<float, float>* xy, float* z, std::size_t count, Kernel kernel)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        alignas(32) float a[8];
+        alignas(32) float b[8];
+        for (std::size_t j = 0; j < 8; ++j)
+        {
+            a[j] = std::get<0>(xy[i + j]);
+            b[j] = std::get<1>(xy[i + j]);
+        }
+        _mm256_storeu_ps(z + i, kernel(_mm256_load_ps(a), _mm256_load_ps(b)));
+    }
+    for (; i < count; ++i)
+    {
+        z[i] = kernel(std::get<0>(xy[i]), std::get<1>(xy[i]));
+    }
+}
+#endif
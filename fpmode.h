@@ -0,0 +1,95 @@
+#pragma once
+
+// Floating-point control modes of the SSE / AVX unit stored in the MXCSR register:
+// Flush-to-zero (FTZ) replaces denormal results by zero, denormals-are-zero (DAZ) treats denormal inputs as zero,
+// and the rounding mode is used by all arithmetic and conversions like cvtss2si (std::lrint).
+// Handling denormals without FTZ / DAZ can be 10-100x slower on many CPUs, because they are handled in microcode.
+// -ffast-math links crtfastmath.o, which enables FTZ and DAZ when the program starts, so denormals are never
+// handled in hardware and builds with and without -ffast-math can differ in speed and accuracy.
+// Note that the x87 unit used for long double reference values has its own control word and is not affected.
+// See: Intel 64 and IA-32 Architectures Software Developer's Manual, Vol. 1, 10.2.3 "MXCSR Control and Status Register"
+// See: https://en.wikipedia.org/wiki/Subnormal_number#Performance_issues
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define APPROX_HAVE_MXCSR
+#endif
+
+/// @brief Combination of floating-point control modes.
+struct FloatMode
+{
+    enum class Rounding : uint32_t
+    {
+        Nearest = 0,
+        Down = 1,
+        Up = 2,
+        TowardZero = 3
+    };
+
+    const char* name; // short name, e.g. "FTZ+DAZ"
+    bool flushToZero; // flush denormal results to zero
+    bool denormalsAreZero; // treat denormal inputs as zero
+    Rounding rounding; // rounding mode
+};
+
+/// @brief Modes to compare. The first one is what -ffast-math uses and the others are compared to it.
+/// The rounding modes are tested with IEEE denormal handling, like in builds without -ffast-math.
+inline const std::vector<FloatMode>& floatModes()
+{
+    static const std::vector<FloatMode> modes = {
+        {"FTZ+DAZ", true, true, FloatMode::Rounding::Nearest},
+        {"FTZ", true, false, FloatMode::Rounding::Nearest},
+        {"DAZ", false, true, FloatMode::Rounding::Nearest},
+        {"IEEE", false, false, FloatMode::Rounding::Nearest},
+        {"IEEE round down", false, false, FloatMode::Rounding::Down},
+        {"IEEE round up", false, false, FloatMode::Rounding::Up},
+        {"IEEE round to zero", false, false, FloatMode::Rounding::TowardZero}};
+    return modes;
+}
+
+/// @brief Returns true if the floating-point modes can be set on this CPU.
+inline bool floatModesSupported()
+{
+#if defined(APPROX_HAVE_MXCSR)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// @brief Set a floating-point mode for the current scope and restore the previous mode when leaving it.
+/// Note that the compiler assumes the default mode and may have evaluated constant expressions at compile time.
+class ScopedFloatMode
+{
+  public:
+    explicit ScopedFloatMode(const FloatMode& mode)
+    {
+#if defined(APPROX_HAVE_MXCSR)
+        m_previous = _mm_getcsr();
+        // FTZ is bit 15, DAZ bit 6 and the rounding mode bits 13-14
+        uint32_t csr = m_previous & ~((1U << 15) | (1U << 6) | (3U << 13));
+        csr |= mode.flushToZero ? (1U << 15) : 0;
+        csr |= mode.denormalsAreZero ? (1U << 6) : 0;
+        csr |= static_cast<uint32_t>(mode.rounding) << 13;
+        _mm_setcsr(csr);
+#else
+        (void)mode;
+#endif
+    }
+
+    ~ScopedFloatMode()
+    {
+#if defined(APPROX_HAVE_MXCSR)
+        _mm_setcsr(m_previous);
+#endif
+    }
+
+    ScopedFloatMode(const ScopedFloatMode&) = delete;
+    ScopedFloatMode& operator=(const ScopedFloatMode&) = delete;
+
+  private:
+    uint32_t m_previous = 0;
+};
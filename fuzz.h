@@ -0,0 +1,301 @@
+#pragma once
+
+// Differential fuzzing: Random bit patterns and edge cases from the input range of a function are fed to an approximation
+// and the results are compared to the reference function. This catches kernels that break silently with a new compiler or
+// new flags, e.g. because type punning through pointers or unions is undefined behaviour the optimizer may exploit.
+// The bit patterns are uniformly distributed, so for floating-point inputs every binade in the range gets the same number
+// of inputs, unlike for the input generators, which distribute the values uniformly.
+// Inputs are checked in blocks in parallel with one random generator per block, so runs with the same seed are reproducible.
+// Failing inputs are minimized by clearing as many of their low bits as possible while they still fail, so they are
+// simple to reproduce, e.g. 1.5 instead of 1.50000012.
+// The tolerances must not come from the run that is checked, or a kernel a compiler breaks everywhere would raise its own
+// tolerance and pass. Non-finite results always fail. Errors are checked against a fixed number of ULPs and / or against
+// the max. errors recorded in a baseline file by an earlier run with a trusted toolchain.
+// See: https://en.wikipedia.org/wiki/Differential_testing and https://llvm.org/docs/LibFuzzer.html
+
+#include "bitops.h"
+#include "input.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// number of inputs checked per block
+static constexpr uint64_t FUZZ_BLOCK_SIZE = 4096;
+// maximum number of minimized failing inputs kept per approximation
+static constexpr std::size_t FUZZ_MAX_FAILURES = 8;
+
+/// @brief Max. errors of an approximation on the test inputs, recorded by a trusted run.
+struct FuzzBaseline
+{
+    std::string suiteName; // name of the test suite, e.g. "sqrtf"
+    std::string name; // identifier / short name of the method "#1"
+    double maxRelativeError = 0; // maximum relative error
+    double maxAbsoluteError = 0; // maximum absolute error
+};
+
+/// @brief Read baselines from a tab-separated file written by writeFuzzBaselines(). Returns none if the file does not exist.
+inline std::vector<FuzzBaseline> readFuzzBaselines(const std::string& fileName)
+{
+    std::vector<FuzzBaseline> baselines;
+    std::ifstream file(fileName);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        FuzzBaseline b;
+        std::string relativeError;
+        std::string absoluteError;
+        if (std::getline(fields, b.suiteName, '\t') && std::getline(fields, b.name, '\t') &&
+            std::getline(fields, relativeError, '\t') && std::getline(fields, absoluteError, '\t'))
+        {
+            b.maxRelativeError = std::strtod(relativeError.c_str(), nullptr);
+            b.maxAbsoluteError = std::strtod(absoluteError.c_str(), nullptr);
+            baselines.push_back(b);
+        }
+    }
+    return baselines;
+}
+
+inline void writeFuzzBaselines(const std::string& fileName, const std::vector<FuzzBaseline>& baselines)
+{
+    std::ofstream file(fileName);
+    file.precision(17);
+    for (const auto& b : baselines)
+    {
+        file << b.suiteName << '\t' << b.name << '\t' << b.maxRelativeError << '\t' << b.maxAbsoluteError << std::endl;
+    }
+}
+
+/// @brief Find the baseline of an approximation. Returns nullptr if there is none.
+inline const FuzzBaseline* findFuzzBaseline(const std::vector<FuzzBaseline>& baselines, const std::string& suiteName, const std::string& name)
+{
+    auto bIt = std::find_if(baselines.cbegin(), baselines.cend(), [&](const FuzzBaseline& b)
+                            { return b.suiteName == suiteName && b.name == name; });
+    return bIt != baselines.cend() ? &*bIt : nullptr;
+}
+
+/// @brief True for the input types that can be fuzzed: float, double and integers.
+template <typename T>
+constexpr bool fuzzSupported()
+{
+    return std::is_integral<T>::value || (std::is_floating_point<T>::value && (sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t)));
+}
+
+/// @brief Unsigned integer with the bits of a float, double or integer value.
+template <typename T>
+using fuzz_bits_t = std::conditional_t<sizeof(T) <= sizeof(uint32_t), std::conditional_t<sizeof(T) <= sizeof(uint16_t), uint16_t, uint32_t>, uint64_t>;
+
+template <typename T>
+fuzz_bits_t<T> fuzzBits(T x)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        return static_cast<fuzz_bits_t<T>>(static_cast<std::make_unsigned_t<T>>(x));
+    }
+    else
+    {
+        fuzz_bits_t<T> bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+}
+
+template <typename T>
+T fromFuzzBits(fuzz_bits_t<T> bits)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        return static_cast<T>(static_cast<std::make_unsigned_t<T>>(bits));
+    }
+    else
+    {
+        T x;
+        std::memcpy(&x, &bits, sizeof(x));
+        return x;
+    }
+}
+
+/// @brief Check if a value is in [range.first, range.second]. Floats are compared using their bits, so NaN is never in the
+/// range and denormals are not treated as zero (DAZ).
+template <typename T>
+bool inFuzzRange(T x, const std::pair<T, T>& range)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        return x >= range.first && x <= range.second;
+    }
+    else
+    {
+        const auto key = totalOrderBits(x);
+        const auto bits = fuzzBits(x);
+        const bool isNaN = (bits & ~(decltype(bits)(1) << (sizeof(bits) * 8 - 1))) > fuzzBits(std::numeric_limits<T>::infinity());
+        return !isNaN && key >= totalOrderBits(range.first) && key <= totalOrderBits(range.second);
+    }
+}
+
+/// @brief Random value with uniformly distributed bits in the range.
+template <typename T>
+T randomFuzzValue(const std::pair<T, T>& range, std::mt19937_64& generator)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        // uniform_int_distribution does not support 8-bit types, so use a wider type
+        std::uniform_int_distribution<std::conditional_t<std::is_signed<T>::value, int64_t, uint64_t>> distribution(range.first, range.second);
+        return static_cast<T>(distribution(generator));
+    }
+    else
+    {
+        std::uniform_int_distribution<fuzz_bits_t<T>> distribution(totalOrderBits(range.first), totalOrderBits(range.second));
+        return fromTotalOrderBits<T>(distribution(generator));
+    }
+}
+
+/// @brief Edge cases in the range: The special values of generateSpecialX(), all powers of two and their neighbours.
+template <typename T>
+std::vector<T> fuzzEdgeCases(const std::pair<T, T>& range)
+{
+    auto values = generateSpecialX<T>(range, 0);
+    if constexpr (std::is_integral<T>::value)
+    {
+        for (int exponent = 0; exponent < std::numeric_limits<T>::digits; ++exponent)
+        {
+            const T power = T(T(1) << exponent);
+            values.insert(values.end(), {T(power - 1), power, T(power + 1), T(-power)});
+        }
+    }
+    else
+    {
+        // from the smallest denormal to the largest normal power of two. denormals are created from their bits,
+        // because -ffast-math flushes them to zero
+        const int mantissaBits = std::numeric_limits<T>::digits - 1;
+        for (int exponent = std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits; exponent < std::numeric_limits<T>::max_exponent; ++exponent)
+        {
+            const int biasedExponent = exponent + std::numeric_limits<T>::max_exponent - 1;
+            const auto bits = biasedExponent > 0 ? fuzz_bits_t<T>(biasedExponent) << mantissaBits : fuzz_bits_t<T>(1) << (mantissaBits - 1 + biasedExponent);
+            for (const auto b : {bits, fuzz_bits_t<T>(bits - 1), fuzz_bits_t<T>(bits + 1)})
+            {
+                const T value = fromFuzzBits<T>(b);
+                values.insert(values.end(), {value, T(-value)});
+            }
+        }
+    }
+    values.erase(std::remove_if(values.begin(), values.end(), [&range](const T& v)
+                                { return !inFuzzRange(v, range); }),
+                 values.end());
+    std::sort(values.begin(), values.end(), [](const T& a, const T& b)
+              { return fuzzBits(a) < fuzzBits(b); });
+    values.erase(std::unique(values.begin(), values.end(), [](const T& a, const T& b)
+                             { return fuzzBits(a) == fuzzBits(b); }),
+                 values.end());
+    return values;
+}
+
+/// @brief Clear as many low bits of a failing input as possible while it still fails and stays in the range.
+/// The sign and exponent of floats and the sign of integers are kept.
+template <typename T, typename Check>
+T minimizeFuzzInput(T x, const std::pair<T, T>& range, Check check)
+{
+    using U = fuzz_bits_t<T>;
+    const int maxBits = std::is_integral<T>::value ? std::numeric_limits<T>::digits : std::numeric_limits<T>::digits - 1;
+    const U bits = fuzzBits(x);
+    for (int clearBits = maxBits; clearBits > 0; --clearBits)
+    {
+        const U mask = clearBits >= int(sizeof(U) * 8) ? U(0) : U(~((U(1) << clearBits) - 1));
+        const T candidate = fromFuzzBits<T>(U(bits & mask));
+        if (fuzzBits(candidate) != bits && inFuzzRange(candidate, range) && check(std::vector<T>{candidate}).front() != 0)
+        {
+            return candidate;
+        }
+    }
+    return x;
+}
+
+/// @brief Check the edge cases of the range and random inputs with uniformly distributed bits in parallel.
+/// @param check Function of type std::vector<char>(const std::vector<T>& values) that returns true for every failing value.
+/// It is called from multiple threads at the same time.
+/// @param inputs Number of random inputs. The edge cases are checked in addition.
+/// @param failures Receives up to FUZZ_MAX_FAILURES minimized failing inputs, sorted ascending by their bits.
+/// @return Number of inputs checked and number of failing inputs.
+template <typename T, typename Check>
+std::pair<uint64_t, uint64_t> fuzz(Check check, const std::pair<T, T>& range, uint64_t inputs, uint64_t seed, std::vector<T>& failures)
+{
+    static_assert(fuzzSupported<T>(), "Only float, double and integers supported");
+    const auto edgeCases = fuzzEdgeCases(range);
+    // block 0 are the edge cases, then blocks of random inputs
+    const uint64_t blocks = 1 + (inputs + FUZZ_BLOCK_SIZE - 1) / FUZZ_BLOCK_SIZE;
+    std::vector<std::vector<T>> blockFailures(blocks);
+    std::atomic<uint64_t> nextBlock(0);
+    std::atomic<uint64_t> failureCount(0);
+    auto worker = [&]()
+    {
+        for (uint64_t b = nextBlock++; b < blocks; b = nextBlock++)
+        {
+            std::vector<T> values;
+            if (b == 0)
+            {
+                values = edgeCases;
+            }
+            else
+            {
+                std::mt19937_64 generator(seed + b);
+                const uint64_t count = std::min<uint64_t>(FUZZ_BLOCK_SIZE, inputs - (b - 1) * FUZZ_BLOCK_SIZE);
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    values.push_back(randomFuzzValue(range, generator));
+                }
+            }
+            const auto failed = check(values);
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                // keep enough failures per block to find FUZZ_MAX_FAILURES different ones in the first blocks
+                if (failed[i] != 0 && blockFailures[b].size() < FUZZ_MAX_FAILURES)
+                {
+                    blockFailures[b].push_back(values[i]);
+                }
+            }
+            failureCount += uint64_t(std::count_if(failed.cbegin(), failed.cend(), [](char f)
+                                                   { return f != 0; }));
+        }
+    };
+    std::vector<std::thread> threads(std::max(1U, std::thread::hardware_concurrency()));
+    for (auto& t : threads)
+    {
+        t = std::thread(worker);
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    // minimize the first failures in block order, so the result does not depend on the order the threads finished in
+    failures.clear();
+    for (const auto& blockFailure : blockFailures)
+    {
+        for (const auto& x : blockFailure)
+        {
+            if (failures.size() >= FUZZ_MAX_FAILURES)
+            {
+                break;
+            }
+            const T minimized = minimizeFuzzInput(x, range, check);
+            if (std::none_of(failures.cbegin(), failures.cend(), [&minimized](const T& f)
+                             { return fuzzBits(f) == fuzzBits(minimized); }))
+            {
+                failures.push_back(minimized);
+            }
+        }
+    }
+    std::sort(failures.begin(), failures.end(), [](const T& a, const T& b)
+              { return fuzzBits(a) < fuzzBits(b); });
+    return {uint64_t(edgeCases.size()) + inputs, failureCount.load()};
+}
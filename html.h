@@ -1,5 +1,6 @@
 #pragma once
 
+#include "pareto.h"
 #include "result.h"
 #include <fstream>
 #include <iomanip>
@@ -65,12 +66,17 @@ void td(std::ostream& os, const typename ResultT::Errors& e)
 template <typename ResultT>
 void td(std::ostream& os, const ResultT& r)
 {
-    os << "<tr>" << std::endl;
+    // grey out approximations that are slower and less accurate than another one
+    os << (r.paretoDominated ? "<tr style=\"color: #aaa\">" : "<tr>") << std::endl;
     os << "<td>" << r.description << "</td>" << std::endl;
     td<ResultT>(os, r.absoluteErrors);
     td<ResultT>(os, r.relativeErrors);
     os << "<td>" << r.stddev << "</td>" << std::endl;
-    os << "<td>" << float(r.callNs - r.overheadNs) / float(r.samplesInRange) << "</td>" << std::endl;
+    os << "<td>" << r.nsPerCall() << " &plusmn; " << r.nsPerCallUncertainty() << "</td>" << std::endl;
+    if (ParetoSettings::enabled)
+    {
+        os << "<td>" << (!r.paretoMeasurable ? "time not measurable" : (r.paretoDominated ? "dominated by " + r.paretoDominatedBy : "optimal")) << "</td>" << std::endl;
+    }
     os << "</tr>" << std::endl;
 }
 
@@ -86,6 +92,10 @@ void table(std::ostream& os, const std::vector<ResultT>& rs)
     os << "<th colspan=5>Relative error</th>" << std::endl;
     os << "<th></th>" << std::endl;
     os << "<th></th>" << std::endl;
+    if (ParetoSettings::enabled)
+    {
+        os << "<th></th>" << std::endl;
+    }
     os << "</tr>" << std::endl;
     os << "<tr>" << std::endl;
     os << "<th>Method</th>" << std::endl;
@@ -101,6 +111,10 @@ void table(std::ostream& os, const std::vector<ResultT>& rs)
     os << "<th>Var.</th>" << std::endl;
     os << "<th>stddev</th>" << std::endl;
     os << "<th>Execution time</br>[ns / call]</th>" << std::endl;
+    if (ParetoSettings::enabled)
+    {
+        os << "<th>Pareto</th>" << std::endl;
+    }
     os << "</tr>" << std::endl;
     os << "</thead>" << std::endl;
     for (const auto& r : rs)
@@ -112,7 +126,7 @@ void table(std::ostream& os, const std::vector<ResultT>& rs)
 }
 
 template <typename ResultT>
-void html(const std::vector<ResultT>& rs, const std::string& fileName, const std::string& plotFileName)
+void html(const std::vector<ResultT>& rs, const std::string& fileName, const std::string& plotFileName, const std::string& bucketPlotFileName = "", const std::string& paretoPlotFileName = "")
 {
     const auto& fr = rs.front();
     std::ofstream htmlFile(fileName);
@@ -120,5 +134,13 @@ void html(const std::vector<ResultT>& rs, const std::string& fileName, const std
     //htmlFile << "<h1 class=\"center\">Results for " << fr.suiteName << "</h1>" << std::endl;
     htmlFile << "<img src=\"" << plotFileName << "\" alt=\"result plot\" class=\"center\">" << std::endl;
     table(htmlFile, rs);
+    if (!bucketPlotFileName.empty())
+    {
+        htmlFile << "<img src=\"" << bucketPlotFileName << "\" alt=\"result plot per binade\" class=\"center\">" << std::endl;
+    }
+    if (!paretoPlotFileName.empty())
+    {
+        htmlFile << "<img src=\"" << paretoPlotFileName << "\" alt=\"speed vs. accuracy plot\" class=\"center\">" << std::endl;
+    }
     htmlFile << HTML5BoilerPlateEnd;
 }
@@ -1,8 +1,18 @@
 #pragma once
 
+#include "bitops.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 template <typename T>
@@ -11,20 +21,397 @@ std::vector<T> generateLinearX(const std::pair<T, T>& range, uint64_t samplesInR
     std::vector<T> values;
     for (uint_fast64_t i = 0; i < samplesInRange; ++i)
     {
-        values.push_back(range.first + ((range.second - range.first) * i) / (samplesInRange - 1));
+        if constexpr (std::is_integral<T>::value)
+        {
+            // (range.second - range.first) * i would overflow for 64 bit types
+            values.push_back(range.first + static_cast<T>(((long double)(range.second - range.first) * i) / (samplesInRange - 1)));
+        }
+        else
+        {
+            values.push_back(range.first + ((range.second - range.first) * i) / (samplesInRange - 1));
+        }
+    }
+    return values;
+}
+
+/// @brief Generate the same number of samples for every power-of-two octave of a non-negative integer range.
+/// This makes sure small values get enough samples too, e.g. for fixed-point numbers where the
+/// relative error grows when only a few bits are used. Samples are spaced linearly in every octave.
+template <typename T>
+std::vector<T> generateOctavesX(const std::pair<T, T>& range, uint64_t samplesInRange)
+{
+    using U = typename std::make_unsigned<T>::type;
+    const U first = static_cast<U>(std::max(range.first, T(0)));
+    const U last = static_cast<U>(std::max(range.second, T(0)));
+    const int firstOctave = bitLength(first);
+    const int lastOctave = bitLength(last);
+    std::vector<T> values;
+    for (int octave = firstOctave; octave <= lastOctave; ++octave)
+    {
+        // octave n holds values with a bit length of n, so [2^(n-1), 2^n - 1]
+        const U octaveFirst = std::max(first, octave == 0 ? U(0) : U(U(1) << (octave - 1)));
+        const U octaveLast = std::min(last, octave == 0 ? U(0) : U(std::numeric_limits<U>::max() >> (std::numeric_limits<U>::digits - octave)));
+        const uint64_t octaveSamples = std::min(uint64_t(octaveLast - octaveFirst) + 1, (samplesInRange - values.size()) / (lastOctave - octave + 1));
+        for (uint_fast64_t i = 0; i < octaveSamples; ++i)
+        {
+            values.push_back(static_cast<T>(octaveFirst + static_cast<U>((static_cast<long double>(octaveLast - octaveFirst) * i) / (octaveSamples > 1 ? octaveSamples - 1 : 1))));
+        }
+    }
+    return values;
+}
+
+/// @brief Generate samples on a logarithmic scale, so every order of magnitude gets a similar number of samples.
+/// Negative parts of the range are mirrored and 0 is included if it is in the range. Magnitudes below the smallest
+/// normal value (or 1 for integers) are not sampled, use generateSpecialX() for denormals.
+/// If equalPerBinade is true every binade [2^n, 2^(n+1)) gets exactly the same number of linearly spaced samples,
+/// otherwise the samples are distributed log-uniformly. The values are sorted ascending.
+template <typename T>
+std::vector<T> generateLogScaleX(const std::pair<T, T>& range, uint64_t samplesInRange, bool equalPerBinade)
+{
+    // calculate in long double, so all float, double and integer values are exact
+    const long double tiny = std::is_integral<T>::value ? 1.0L : static_cast<long double>(std::numeric_limits<T>::min());
+    const long double first = static_cast<long double>(range.first);
+    const long double last = static_cast<long double>(range.second);
+    std::vector<T> values;
+    if (first <= 0 && last >= 0)
+    {
+        values.push_back(T(0));
+    }
+    // magnitude ranges [lo, hi] and sign of the negative and positive part of the range
+    std::vector<std::tuple<long double, long double, long double>> parts;
+    if (first <= -tiny)
+    {
+        parts.push_back({std::max(-last, tiny), -first, -1.0L});
+    }
+    if (last >= tiny)
+    {
+        parts.push_back({std::max(first, tiny), last, 1.0L});
+    }
+    // distribute the samples by the number of binades in every part
+    long double totalWeight = 0;
+    for (const auto& part : parts)
+    {
+        totalWeight += std::log2(std::get<1>(part)) - std::log2(std::get<0>(part)) + 1;
+    }
+    for (const auto& part : parts)
+    {
+        const auto [lo, hi, sign] = part;
+        const uint64_t partSamples = std::max(uint64_t(1), static_cast<uint64_t>((samplesInRange - values.size()) * (std::log2(hi) - std::log2(lo) + 1) / totalWeight));
+        totalWeight -= std::log2(hi) - std::log2(lo) + 1;
+        std::vector<long double> magnitudes;
+        if (equalPerBinade)
+        {
+            const int firstBinade = std::ilogb(lo);
+            const int lastBinade = std::ilogb(hi);
+            for (int binade = firstBinade; binade <= lastBinade; ++binade)
+            {
+                // the upper limit of a binade is the first value of the next one, so it is only included for the last binade
+                const long double binadeFirst = std::max(lo, std::ldexp(1.0L, binade));
+                const long double binadeLast = std::min(hi, std::ldexp(1.0L, binade + 1));
+                const uint64_t binadeSamples = (partSamples - magnitudes.size()) / (lastBinade - binade + 1);
+                const uint64_t steps = binade == lastBinade ? std::max(uint64_t(1), binadeSamples - 1) : binadeSamples;
+                for (uint_fast64_t i = 0; i < binadeSamples; ++i)
+                {
+                    magnitudes.push_back(binadeFirst + ((binadeLast - binadeFirst) * i) / steps);
+                }
+            }
+        }
+        else
+        {
+            const long double logLo = std::log2(lo);
+            const long double logHi = std::log2(hi);
+            for (uint_fast64_t i = 0; i < partSamples; ++i)
+            {
+                magnitudes.push_back(std::exp2(logLo + ((logHi - logLo) * i) / (partSamples > 1 ? partSamples - 1 : 1)));
+            }
+        }
+        for (const auto& m : magnitudes)
+        {
+            // rounding could move values slightly out of the range, e.g. 2^64 for the maximum uint64_t
+            values.push_back(static_cast<T>(sign * std::clamp(std::is_integral<T>::value ? std::round(m) : m, lo, hi)));
+        }
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+/// @brief Generate log-uniformly distributed samples. See generateLogScaleX().
+template <typename T>
+std::vector<T> generateLogX(const std::pair<T, T>& range, uint64_t samplesInRange)
+{
+    return generateLogScaleX(range, samplesInRange, false);
+}
+
+/// @brief Generate the same number of samples for every binade [2^n, 2^(n+1)). See generateLogScaleX().
+/// For integers this is the same as generateOctavesX().
+template <typename T>
+std::vector<T> generateBinadesX(const std::pair<T, T>& range, uint64_t samplesInRange)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        return generateOctavesX(range, samplesInRange);
+    }
+    else
+    {
+        return generateLogScaleX(range, samplesInRange, true);
+    }
+}
+
+/// @brief Generate uniformly distributed random values in a range. The same seed always generates the same values.
+/// The values are not sorted, so branches depending on the input value are hard to predict.
+/// Use a lambda to bind the seed, so it can be used as an input generator.
+template <typename T>
+std::vector<T> generateRandomX(const std::pair<T, T>& range, uint64_t samplesInRange, uint64_t seed)
+{
+    std::vector<T> values;
+    std::mt19937_64 mt(seed);
+    if constexpr (std::is_integral<T>::value)
+    {
+        // uniform_int_distribution does not support 8-bit types, so use a wider type
+        std::uniform_int_distribution<std::conditional_t<std::is_signed<T>::value, int64_t, uint64_t>> dist(range.first, range.second);
+        for (uint_fast64_t i = 0; i < samplesInRange; ++i)
+        {
+            values.push_back(static_cast<T>(dist(mt)));
+        }
+    }
+    else
+    {
+        std::uniform_real_distribution<T> dist(range.first, range.second);
+        for (uint_fast64_t i = 0; i < samplesInRange; ++i)
+        {
+            values.push_back(dist(mt));
+        }
+    }
+    return values;
+}
+
+/// @brief Generate edge cases: zero, denormals, the smallest and largest normal values, infinities and NaN
+/// (or 0, 1, powers of two and the limits of the type for integers) plus the range limits and their neighbours.
+/// The range is NOT applied to the other values, because these are meant to check what happens outside of the range
+/// of a function, so expect infinite or NaN errors. samplesInRange is ignored. The values are sorted ascending with NaNs at the ends.
+template <typename T>
+std::vector<T> generateSpecialX(const std::pair<T, T>& range, uint64_t /*samplesInRange*/)
+{
+    using limits = std::numeric_limits<T>;
+    std::vector<T> values;
+    if constexpr (std::is_integral<T>::value)
+    {
+        values = {limits::min(), T(limits::min() + 1), T(0), T(1), T(2), T(3), T(limits::max() / 2), T(limits::max() / 2 + 1), T(limits::max() - 1), limits::max()};
+        if constexpr (std::is_signed<T>::value)
+        {
+            values.push_back(T(-1));
+        }
+        values.push_back(range.first);
+        values.push_back(range.first < limits::max() ? T(range.first + 1) : range.first);
+        values.push_back(range.second > limits::min() ? T(range.second - 1) : range.second);
+        values.push_back(range.second);
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+    else
+    {
+        // denormals are created with nextafter() and -0 from its bits, because -ffast-math flushes denormal results
+        // of arithmetic to zero and does not care about the sign of zero
+        using U = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+        static_assert(sizeof(T) == sizeof(U), "Only float and double supported");
+        const U signBit = U(1) << (sizeof(U) * 8 - 1);
+        T negativeZero;
+        std::memcpy(&negativeZero, &signBit, sizeof(negativeZero));
+        const T positive[] = {
+            limits::denorm_min(), std::nextafter(limits::denorm_min(), T(1)), std::nextafter(limits::min(), T(0)),
+            limits::min(), std::nextafter(limits::min(), T(1)), std::nextafter(T(1), T(0)), T(1), std::nextafter(T(1), T(2)),
+            std::nextafter(limits::max(), T(0)), limits::max(), limits::infinity(), limits::quiet_NaN()};
+        values = {negativeZero, T(0)};
+        for (const auto& v : positive)
+        {
+            values.push_back(v);
+            values.push_back(-v);
+        }
+        for (const auto& v : {range.first, range.second})
+        {
+            values.push_back(std::nextafter(v, -limits::infinity()));
+            values.push_back(v);
+            values.push_back(std::nextafter(v, limits::infinity()));
+        }
+        // sort and compare using the bit patterns, because denormals compare equal to zero if the CPU flushes them (DAZ)
+        std::sort(values.begin(), values.end(), [](const T& a, const T& b)
+                  { return totalOrderBits(a) < totalOrderBits(b); });
+        values.erase(std::unique(values.begin(), values.end(), [](const T& a, const T& b)
+                                 { return totalOrderBits(a) == totalOrderBits(b); }),
+                     values.end());
+    }
+    return values;
+}
+
+/// @brief Generate log-uniformly distributed denormal values, so every binade of the denormal range gets a similar number of samples.
+/// Negative values are generated too if the range includes negative values, otherwise the range is ignored, because most
+/// test suites limit their range to normal values. Denormals are created from their bits, because -ffast-math flushes
+/// denormal results of arithmetic to zero. Use to measure the effect of FTZ / DAZ (see fpmode.h). The values are sorted ascending.
+template <typename T>
+std::vector<T> generateDenormalsX(const std::pair<T, T>& range, uint64_t samplesInRange)
+{
+    static_assert(std::is_floating_point<T>::value && (sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t)), "Only float and double supported");
+    using U = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    // denormals are mantissa * denorm_min, so log-uniform mantissa bits are log-uniform values
+    const U maxMantissa = (U(1) << (std::numeric_limits<T>::digits - 1)) - 1;
+    const U signBit = U(1) << (sizeof(U) * 8 - 1);
+    const bool negative = range.first < 0;
+    const uint64_t positiveSamples = negative ? samplesInRange / 2 : samplesInRange;
+    std::vector<T> values;
+    for (uint64_t i = 0; i < samplesInRange; ++i)
+    {
+        const uint64_t j = i < positiveSamples ? i : i - positiveSamples;
+        const uint64_t sideSamples = i < positiveSamples ? positiveSamples : samplesInRange - positiveSamples;
+        const long double logMantissa = (std::log2(static_cast<long double>(maxMantissa)) * j) / (sideSamples > 1 ? sideSamples - 1 : 1);
+        U bits = std::clamp(static_cast<U>(std::llround(std::exp2(logMantissa))), U(1), maxMantissa);
+        bits |= i < positiveSamples ? U(0) : signBit;
+        T x;
+        std::memcpy(&x, &bits, sizeof(x));
+        values.push_back(x);
+    }
+    std::sort(values.begin(), values.end(), [](const T& a, const T& b)
+              { return totalOrderBits(a) < totalOrderBits(b); });
+    return values;
+}
+
+/// @brief Read input values from a text file, e.g. values logged from a real application, so results match the distribution
+/// that is actually used. Values are separated by whitespace. Floating-point values can also be "inf", "nan" or hex floats.
+/// The range and samplesInRange are ignored and all values are returned in file order.
+/// Use a lambda to bind the file name, so it can be used as an input generator.
+template <typename T>
+std::vector<T> generateFromFileX(const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open input file \"" + fileName + "\"");
+    }
+    std::vector<T> values;
+    std::string token;
+    while (file >> token)
+    {
+        char* end = nullptr;
+        if constexpr (std::is_integral<T>::value)
+        {
+            if constexpr (std::is_signed<T>::value)
+            {
+                values.push_back(static_cast<T>(std::strtoll(token.c_str(), &end, 0)));
+            }
+            else
+            {
+                values.push_back(static_cast<T>(std::strtoull(token.c_str(), &end, 0)));
+            }
+        }
+        else
+        {
+            values.push_back(static_cast<T>(std::strtold(token.c_str(), &end)));
+        }
+        if (end == token.c_str() || *end != '\0')
+        {
+            throw std::runtime_error("Invalid value \"" + token + "\" in input file \"" + fileName + "\"");
+        }
+    }
+    if (values.empty())
+    {
+        throw std::runtime_error("No values in input file \"" + fileName + "\"");
     }
     return values;
 }
 
+/// @brief Generate values densely around every power of two 2^n in a non-negative integer range,
+/// so 2^n - k ... 2^n + k - 1 for all n. Integer algorithms often have bugs or timing differences
+/// at those boundaries, e.g. where the number of leading zeros changes. The values are sorted and unique
+/// and always include the range limits, but there may be less than samplesInRange values for small ranges.
 template <typename T>
-std::vector<T> generateRandomXY(const std::pair<T, T>& range, uint64_t samplesInRange)
+std::vector<T> generatePowerOfTwoBoundariesX(const std::pair<T, T>& range, uint64_t samplesInRange)
+{
+    using U = typename std::make_unsigned<T>::type;
+    const U first = static_cast<U>(std::max(range.first, T(0)));
+    const U last = static_cast<U>(std::max(range.second, T(0)));
+    // boundaries 2^n that have values on both sides in the range
+    const int firstBoundary = std::max(bitLength(first), 1);
+    const int lastBoundary = bitLength(last) - 1;
+    std::vector<T> values;
+    values.push_back(static_cast<T>(first));
+    if (lastBoundary >= firstBoundary)
+    {
+        const uint64_t halfWidth = std::max(uint64_t(1), (samplesInRange - 2) / (2 * (lastBoundary - firstBoundary + 1)));
+        for (int n = firstBoundary; n <= lastBoundary; ++n)
+        {
+            const U boundary = U(1) << n;
+            const U below = std::min(uint64_t(boundary - first), halfWidth);
+            const U above = std::min(uint64_t(last - boundary) + 1, halfWidth);
+            for (U v = boundary - below; v != boundary + above; ++v)
+            {
+                values.push_back(static_cast<T>(v));
+            }
+        }
+    }
+    values.push_back(static_cast<T>(last));
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+/// @brief Generate half of the samples linearly over the range and the other half densely in [knee - width, knee + width]
+/// around every knee, e.g. 0 and the points where a sigmoid-shaped function starts to saturate, where errors matter most.
+/// Use a lambda to bind the knees and width, so it can be used as an input generator. The values are sorted ascending.
+template <typename T>
+std::vector<T> generateKneesX(const std::pair<T, T>& range, uint64_t samplesInRange, const std::vector<T>& knees, T width)
+{
+    const uint64_t kneeSamples = knees.empty() ? 0 : (samplesInRange / 2) / knees.size();
+    std::vector<T> values = generateLinearX(range, samplesInRange - kneeSamples * knees.size());
+    for (const auto& knee : knees)
+    {
+        const T first = std::max(range.first, knee - width);
+        const T last = std::min(range.second, knee + width);
+        for (uint_fast64_t i = 0; i < kneeSamples; ++i)
+        {
+            values.push_back(first + ((last - first) * i) / (kneeSamples > 1 ? kneeSamples - 1 : 1));
+        }
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+/// @brief Generate all values of a 16-bit floating-point type (e.g. half_t or bfloat16) in a range.
+/// NaNs are skipped and the values are sorted ascending. samplesInRange is ignored, because the number of values is given by the range.
+template <typename T>
+std::vector<T> generateExhaustive16X(const std::pair<T, T>& range, uint64_t /*samplesInRange*/)
+{
+    static_assert(sizeof(T) == sizeof(uint16_t), "Only 16-bit types supported");
+    const float first = static_cast<float>(range.first);
+    const float last = static_cast<float>(range.second);
+    std::vector<T> values;
+    for (uint32_t bits = 0; bits <= 0xFFFF; ++bits)
+    {
+        T x;
+        const uint16_t b = static_cast<uint16_t>(bits);
+        std::memcpy(&x, &b, sizeof(x));
+        // check for NaN using the bits, because -ffast-math assumes there are no NaNs
+        const float f = static_cast<float>(x);
+        uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        if ((u & 0x7FFFFFFF) <= 0x7F800000 && f >= first && f <= last)
+        {
+            values.push_back(x);
+        }
+    }
+    std::sort(values.begin(), values.end(), [](const T& a, const T& b)
+              { return static_cast<float>(a) < static_cast<float>(b); });
+    return values;
+}
+
+/// @brief Generate uniformly distributed random 2D values in a box plus (0, 0), e.g. std::tuple<float, float>.
+/// The same seed always generates the same values. Use a lambda to bind the seed, like for generateRandomX().
+template <typename T>
+std::vector<T> generateRandomXY(const std::pair<T, T>& range, uint64_t samplesInRange, uint64_t seed)
 {
     std::vector<T> values;
     values.push_back({0, 0});
-    std::random_device rd;
-    std::mt19937 mt(rd());
-    std::uniform_real_distribution<typename T::first_type> distX(range.first.first, range.second.first);
-    std::uniform_real_distribution<typename T::second_type> distY(range.first.second, range.second.second);
+    std::mt19937_64 mt(seed);
+    std::uniform_real_distribution<std::tuple_element_t<0, T>> distX(std::get<0>(range.first), std::get<0>(range.second));
+    std::uniform_real_distribution<std::tuple_element_t<1, T>> distY(std::get<1>(range.first), std::get<1>(range.second));
     for (uint_fast64_t i = 0; i < samplesInRange - 1; ++i)
     {
         values.push_back({distX(mt), distY(mt)});
@@ -32,6 +419,23 @@ std::vector<T> generateRandomXY(const std::pair<T, T>& range, uint64_t samplesIn
     return values;
 }
 
+/// @brief Generate uniformly distributed random 3D vectors in a box, e.g. std::tuple<float, float, float>.
+/// The same seed always generates the same values. Use a lambda to bind the seed, like for generateRandomX().
+template <typename T>
+std::vector<T> generateRandomXYZ(const std::pair<T, T>& range, uint64_t samplesInRange, uint64_t seed)
+{
+    std::vector<T> values;
+    std::mt19937_64 mt(seed);
+    std::uniform_real_distribution<std::tuple_element_t<0, T>> distX(std::get<0>(range.first), std::get<0>(range.second));
+    std::uniform_real_distribution<std::tuple_element_t<1, T>> distY(std::get<1>(range.first), std::get<1>(range.second));
+    std::uniform_real_distribution<std::tuple_element_t<2, T>> distZ(std::get<2>(range.first), std::get<2>(range.second));
+    for (uint_fast64_t i = 0; i < samplesInRange; ++i)
+    {
+        values.push_back({distX(mt), distY(mt), distZ(mt)});
+    }
+    return values;
+}
+
 template <typename T>
 std::vector<T> generateCirclesXY(const std::pair<T, T>& range, uint64_t samplesInRange)
 {
@@ -58,7 +462,8 @@ std::vector<T> generateCirclesXY(const std::pair<T, T>& range, uint64_t samplesI
         for (uint_fast64_t ti = 0; ti < steps; ++ti)
         {
             const double t = ti * stepT;
-            values.push_back({r * std::cos(t), r * std::sin(t)});
+            // cast explicitly, so integer coordinates e.g. for fixed-point numbers work too
+            values.push_back({static_cast<std::tuple_element_t<0, T>>(r * std::cos(t)), static_cast<std::tuple_element_t<1, T>>(r * std::sin(t))});
         }
     }
     return values;
@@ -0,0 +1,92 @@
+#pragma once
+
+// Compare kernels compiled for the x86-64 microarchitecture levels: v1 (SSE2), v2 (+ SSE4.2, POPCNT), v3 (+ AVX2, FMA, BMI2)
+// and v4 (+ AVX-512). CMake builds isa_kernels.cpp once per level as plugin approx_isa_<level>.so (see plugin.h).
+// The levels the CPU supports are loaded at runtime, so the results show what a deployment baseline costs or gains.
+// See: https://en.wikipedia.org/wiki/X86-64#Microarchitecture_levels
+
+#include "plugin.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+/// @brief Names of the ISA levels. Also used in the library file names and as prefix of the result names.
+inline const std::vector<std::string>& isaLevels()
+{
+    static const std::vector<std::string> levels = {"x86-64-v1", "x86-64-v2", "x86-64-v3", "x86-64-v4"};
+    return levels;
+}
+
+/// @brief Returns true if the CPU and OS support the instructions of an ISA level.
+/// Only the main features of every level are checked, e.g. not CMPXCHG16B or MOVBE.
+inline bool isaSupported(const std::string& level)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    const bool v2 = __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+    const bool v3 = v2 && __builtin_cpu_supports("avx") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2");
+    const bool v4 = v3 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+    return level == "x86-64-v1" || (level == "x86-64-v2" && v2) || (level == "x86-64-v3" && v3) || (level == "x86-64-v4" && v4);
+#else
+    (void)level;
+    return false;
+#endif
+}
+
+/// @brief Load the kernels of all ISA levels the CPU supports from the directory of the executable and add them to kernels.
+/// Levels the CPU does not support or that were not built are skipped with a message. The kernels are ordered by suite and
+/// name, then by level, so the same kernel is listed for all levels side by side. Returns false if no level could be loaded.
+inline bool loadIsaKernels(std::vector<PluginKernel>& kernels)
+{
+    std::error_code error;
+    auto directory = std::filesystem::read_symlink("/proc/self/exe", error).parent_path();
+    if (error)
+    {
+        directory = std::filesystem::current_path();
+    }
+    std::vector<PluginKernel> isaKernels;
+    for (const auto& level : isaLevels())
+    {
+        const auto path = directory / ("approx_isa_" + level + ".so");
+        if (!isaSupported(level))
+        {
+            std::cout << "Skipping " << level << ": Not supported by this CPU" << std::endl;
+        }
+        else if (!std::filesystem::exists(path))
+        {
+            std::cout << "Skipping " << level << ": " << path.string() << " was not built" << std::endl;
+        }
+        else if (!loadPlugin(path.string(), isaKernels, level))
+        {
+            return false;
+        }
+    }
+    if (isaKernels.empty())
+    {
+        return false;
+    }
+    // order of first appearance of every kernel. lower levels can have less kernels, e.g. no AVX2 batch functions
+    std::vector<const PluginKernel*> order;
+    for (const auto& k : isaKernels)
+    {
+        if (std::find_if(order.cbegin(), order.cend(), [&k](const PluginKernel* o)
+                         { return std::string(o->kernel.suite) == k.kernel.suite && std::string(o->kernel.name) == k.kernel.name; }) == order.cend())
+        {
+            order.push_back(&k);
+        }
+    }
+    for (const auto* o : order)
+    {
+        for (const auto& k : isaKernels)
+        {
+            if (std::string(o->kernel.suite) == k.kernel.suite && std::string(o->kernel.name) == k.kernel.name)
+            {
+                kernels.push_back(k);
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,181 @@
+// Kernels of the float and double suites as plugin (see approx_plugin.h). CMake compiles this file once per x86-64
+// ISA level into approx_isa_<level>.so, so the same source can be compared when compiled for SSE2, SSE4.2, AVX2 + FMA
+// and AVX-512. The batch kernels need AVX2 and only exist from x86-64-v3 on. Every library has its own copy of all code,
+// so inline functions compiled for a higher level can never end up in code for a lower level. See isa.h.
+
+#include "approx_plugin.h"
+#include "test_activationf.h"
+#include "test_cbrtf.h"
+#include "test_exp2f.h"
+#include "test_invsqrtd.h"
+#include "test_invsqrtf.h"
+#include "test_log10d.h"
+#include "test_log10f.h"
+#include "test_log2f.h"
+#include "test_recipf.h"
+#include "test_sqrtd.h"
+#include "test_sqrtf.h"
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+ApproxKernel scalarKernel(const char* suite, const char* name, T (*function)(T))
+{
+    const auto type = static_cast<ApproxType>(approxType<T>());
+    // no description, so the one of the built-in approximation with the same name is used
+    return {suite, name, nullptr, type, type, reinterpret_cast<ApproxFunction>(function), nullptr, 0, 0};
+}
+
+template <typename T, void (*Function)(const T*, T*, std::size_t)>
+void batchFunction(const void* x, void* y, std::size_t count)
+{
+    Function(static_cast<const T*>(x), static_cast<T*>(y), count);
+}
+
+template <typename T, void (*Function)(const T*, T*, std::size_t)>
+ApproxKernel batchKernel(const char* suite, const char* name)
+{
+    const auto type = static_cast<ApproxType>(approxType<T>());
+    return {suite, name, nullptr, type, type, nullptr, &batchFunction<T, Function>, 0, 0};
+}
+
+// Same names and order as in runTests() of the suites
+std::vector<ApproxKernel> isaKernels()
+{
+    return {
+        scalarKernel("sqrtf", "#0", &sqrtf_0),
+        scalarKernel("sqrtf", "#1", &sqrtf_1),
+        scalarKernel("sqrtf", "#2", &sqrtf_2),
+        scalarKernel("sqrtf", "#3", &sqrtf_3),
+        scalarKernel("sqrtf", "#4", &sqrtf_4),
+        scalarKernel("sqrtf", "#5", &sqrtf_5),
+        scalarKernel("sqrtf", "#6", &sqrtf_6),
+        scalarKernel("sqrtf", "#7", &sqrtf_7),
+        scalarKernel("sqrtf", "#8", &sqrtf_8),
+        scalarKernel("sqrtf", "#9", &sqrtf_9),
+        scalarKernel("sqrtf", "#10", &sqrtf_10),
+        scalarKernel("sqrtf", "#11", &sqrtf_11),
+        scalarKernel("sqrtf", "#12", &sqrtf_12),
+        scalarKernel("sqrtf", "#13", &sqrtf_13),
+        scalarKernel("sqrtf", "#14", &sqrtf_14),
+        scalarKernel("sqrtf", "#15", &sqrtf_15),
+        scalarKernel("invsqrtf", "#0", &invsqrtf_0),
+        scalarKernel("invsqrtf", "#1", &invsqrtf_1),
+        scalarKernel("invsqrtf", "#2", &invsqrtf_2),
+        scalarKernel("recipf", "#0", &recipf_0),
+        scalarKernel("recipf", "#1", &recipf_1),
+        scalarKernel("recipf", "#2", &recipf_2),
+        scalarKernel("recipf", "#3", &recipf_3),
+        scalarKernel("recipf", "#4", &recipf_4),
+#if defined(__SSE__)
+        scalarKernel("recipf", "#5", &recipf_5),
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+        batchKernel<float, &recipf_6>("recipf", "#6"),
+        batchKernel<float, &recipf_7>("recipf", "#7"),
+        batchKernel<float, &recipf_8>("recipf", "#8"),
+#endif
+        scalarKernel("cbrtf", "#0", &cbrtf_0),
+        scalarKernel("cbrtf", "#1", &cbrtf_1),
+        scalarKernel("cbrtf", "#2", &cbrtf_2),
+        scalarKernel("cbrtf", "#3", &cbrtf_3),
+        scalarKernel("cbrtf", "#4", &cbrtf_4),
+        scalarKernel("cbrtf", "#5", &cbrtf_5),
+        scalarKernel("cbrtf", "#6", &cbrtf_6),
+        scalarKernel("exp2f", "#0", &exp2f_0),
+        scalarKernel("exp2f", "#1", &exp2f_1),
+        scalarKernel("exp2f", "#2", &exp2f_2),
+        scalarKernel("exp2f", "#3", &exp2f_3),
+        scalarKernel("exp2f", "#4", &exp2f_4),
+#if defined(__AVX2__) && defined(__FMA__)
+        batchKernel<float, &exp2f_5>("exp2f", "#5"),
+        batchKernel<float, &exp2f_6>("exp2f", "#6"),
+        batchKernel<float, &exp2f_7>("exp2f", "#7"),
+#endif
+        scalarKernel("log2f", "#0", &log2f_0),
+        scalarKernel("log2f", "#1", &log2f_1),
+        scalarKernel("log2f", "#2", &log2f_2),
+        scalarKernel("log2f", "#3", &log2f_3),
+        scalarKernel("log2f", "#4", &log2f_4),
+#if defined(__AVX2__) && defined(__FMA__)
+        batchKernel<float, &log2f_5>("log2f", "#5"),
+        batchKernel<float, &log2f_6>("log2f", "#6"),
+        batchKernel<float, &log2f_7>("log2f", "#7"),
+#endif
+        scalarKernel("log10f", "#0", &log10f_0),
+        scalarKernel("log10f", "#1", &log10f_1),
+        scalarKernel("log10f", "#2", &log10f_2),
+        scalarKernel("log10f", "#3", &log10f_3),
+        scalarKernel("log10f", "#4", &log10f_4),
+        scalarKernel("log10f", "#5", &log10f_5),
+#if defined(__AVX2__) && defined(__FMA__)
+        batchKernel<float, &log10f_6>("log10f", "#6"),
+#endif
+        scalarKernel("tanhf", "#0", &tanhf_0),
+        scalarKernel("tanhf", "#1", &tanhf_1),
+        scalarKernel("tanhf", "#2", &tanhf_2),
+        scalarKernel("tanhf", "#3", &tanhf_3),
+        scalarKernel("tanhf", "#4", &tanhf_4),
+#if defined(__AVX2__) && defined(__FMA__)
+        batchKernel<float, &tanhf_5>("tanhf", "#5"),
+        batchKernel<float, &tanhf_6>("tanhf", "#6"),
+        batchKernel<float, &tanhf_7>("tanhf", "#7"),
+        batchKernel<float, &tanhf_8>("tanhf", "#8"),
+#endif
+        scalarKernel("sigmoidf", "#0", &sigmoidf_0),
+        scalarKernel("sigmoidf", "#1", &sigmoidf_1),
+        scalarKernel("sigmoidf", "#2", &sigmoidf_2),
+        scalarKernel("sigmoidf", "#3", &sigmoidf_3),
+        scalarKernel("sigmoidf", "#4", &sigmoidf_4),
+#if defined(__AVX2__) && defined(__FMA__)
+        batchKernel<float, &sigmoidf_5>("sigmoidf", "#5"),
+        batchKernel<float, &sigmoidf_6>("sigmoidf", "#6"),
+        batchKernel<float, &sigmoidf_7>("sigmoidf", "#7"),
+#endif
+        scalarKernel("erff", "#0", &erff_0),
+        scalarKernel("erff", "#1", &erff_1),
+        scalarKernel("erff", "#2", &erff_2),
+        scalarKernel("erff", "#3", &erff_3),
+#if defined(__AVX2__) && defined(__FMA__)
+        batchKernel<float, &erff_4>("erff", "#4"),
+        batchKernel<float, &erff_5>("erff", "#5"),
+        batchKernel<float, &erff_6>("erff", "#6"),
+#endif
+        scalarKernel("sqrtd", "#0", &sqrtd_0),
+        scalarKernel("sqrtd", "#1", &sqrtd_1),
+        scalarKernel("sqrtd", "#2", &sqrtd_2),
+        scalarKernel("sqrtd", "#3", &sqrtd_3),
+        scalarKernel("sqrtd", "#4", &sqrtd_4),
+        scalarKernel("sqrtd", "#5", &sqrtd_5),
+        scalarKernel("sqrtd", "#6", &sqrtd_6),
+#if defined(__AVX2__)
+        batchKernel<double, &sqrtd_7>("sqrtd", "#7"),
+        batchKernel<double, &sqrtd_8>("sqrtd", "#8"),
+#endif
+        scalarKernel("invsqrtd", "#0", &invsqrtd_0),
+        scalarKernel("invsqrtd", "#1", &invsqrtd_1),
+        scalarKernel("invsqrtd", "#2", &invsqrtd_2),
+        scalarKernel("invsqrtd", "#3", &invsqrtd_3),
+        scalarKernel("invsqrtd", "#4", &invsqrtd_4),
+#if defined(__AVX2__)
+        batchKernel<double, &invsqrtd_5>("invsqrtd", "#5"),
+        batchKernel<double, &invsqrtd_6>("invsqrtd", "#6"),
+#endif
+        scalarKernel("log10d", "#0", &log10d_0),
+        scalarKernel("log10d", "#1", &log10d_1),
+        scalarKernel("log10d", "#2", &log10d_2),
+        scalarKernel("log10d", "#3", &log10d_3),
+        scalarKernel("log10d", "#4", &log10d_4),
+        batchKernel<double, &log10d_5>("log10d", "#5"),
+#if defined(__AVX2__)
+        batchKernel<double, &log10d_6>("log10d", "#6"),
+#endif
+    };
+}
+
+extern "C" APPROX_PLUGIN_EXPORT const ApproxPlugin* approx_plugin(void)
+{
+    static const std::vector<ApproxKernel> kernels = isaKernels();
+    static const ApproxPlugin plugin = {APPROX_PLUGIN_ABI_VERSION, kernels.size(), kernels.data()};
+    return &plugin;
+}
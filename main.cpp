@@ -1,30 +1,84 @@
 // Test spped and precision of transcendental function approximations
 
+#include "fpmode.h"
 #include "html.h"
 #include "input.h"
+#include "isa.h"
+#include "mca.h"
+#include "pareto.h"
 #include "plot.h"
+#include "plugin.h"
+#include "report.h"
+#include "test_activationf.h"
 #include "test_atan2f.h"
+#include "test_atan2q15.h"
+#include "test_cbrtf.h"
+#include "test_exp2f.h"
 #include "test_expf.h"
+#include "test_float16.h"
+#include "test_invsqrtd.h"
 #include "test_invsqrtf.h"
+#include "test_invsqrtq16.h"
+#include "test_log10d.h"
 #include "test_log10f.h"
+#include "test_log2f.h"
+#include "test_logi.h"
+#include "test_logq15.h"
+#include "test_normalizef.h"
+#include "test_powf.h"
+#include "test_recipf.h"
+#include "test_sincosf.h"
+#include "test_sqrtd.h"
 #include "test_sqrtf.h"
+#include "test_sqrtfcompose.h"
 #include "test_sqrti.h"
+#include "test_sqrtq16.h"
 #include <cstdio>
+#include <cstring>
 #include <cxxopts.hpp>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <vector>
 
 std::string m_approxFunc = "sqrtf";
 std::string m_plotFormat = "";
+bool m_fuzzFailed = false;
+std::string m_fuzzBaselineFile = "";
+std::string m_inputGenerator = "";
+std::string m_inputFile = "";
+uint64_t m_randomSeed = 42;
+uint64_t m_samples = 0;
 
 bool readArguments(int argc, char**& argv)
 {
     cxxopts::Options options("approx", "Test transcendental function approximations");
     options.allow_unrecognised_options();
     options.add_option("", {"h,help", "Print help"});
-    options.add_option("", {"p,plot", "Plot results using GNUplot. Supported: \"pdf\" or \"html\"", cxxopts::value<std::string>()});
-    options.add_option("", {"f,function", "Name of function to test. Supported: \"expf\", \"log10f\", \"invsqrtf\", \"sqrti\", \"sqrtf\" or \"atan2f\"", cxxopts::value<std::string>()});
+    options.add_option("", {"p,plot", "Plot results using GNUplot. Supported: \"pdf\", \"html\" or \"report\" (HTML without GNUplot)", cxxopts::value<std::string>()});
+    options.add_option("", {"f,function", "Name of function to test. Supported: \"expf\", \"exp2f\", \"log2f\", \"powf\", \"tanhf\", \"sigmoidf\", \"erff\", \"log10f\", \"log10d\", \"invsqrtf\", \"invsqrtd\", \"sqrti16\", \"sqrti\", \"sqrti64\", \"log2i\", \"log2i64\", \"log10i\", \"log10i64\", \"recipf\", \"sqrtf\", \"sqrtfcompose\", \"sqrtd\", \"cbrtf\", \"normalize3f\", \"sincosf\", \"invsqrth\", \"exph\", \"logh\", \"invsqrtbf16\", \"expbf16\", \"logbf16\", \"sqrtq16\", \"invsqrtq16\", \"log2q15\", \"log10q15\", \"atan2q15\" or \"atan2f\"", cxxopts::value<std::string>()});
+    options.add_option("", {"plot-width", "Width of the plot in pixels", cxxopts::value<unsigned>()});
+    options.add_option("", {"i,input", "Input value generator. Supported: \"linear\", \"log\", \"binades\", \"random\", \"special\", \"denormals\" or \"file\"", cxxopts::value<std::string>()});
+    options.add_option("", {"s,seed", "Seed for the \"random\" input generator and the random inputs of powf and normalize3f", cxxopts::value<uint64_t>()});
+    options.add_option("", {"input-file", "Text file with input values for the \"file\" input generator", cxxopts::value<std::string>()});
+    options.add_option("", {"n,samples", "Number of input values instead of the default of the function", cxxopts::value<uint64_t>()});
+    options.add_option("", {"min-time", "Minimum time per measurement in seconds. Default is 0.1", cxxopts::value<double>()});
+    options.add_option("", {"max-time", "Maximum time per measurement in seconds. Default is 2", cxxopts::value<double>()});
+    options.add_option("", {"q,quick", "Less samples and shorter measurements for a quick overview"});
+    options.add_option("", {"o,orders", "Also time all functions with the input values sorted, shuffled and in alternating order"});
+    options.add_option("", {"b,buckets", "Also list errors and execution time per binade of the input values"});
+    options.add_option("", {"m,modes", "Also time and check all functions with different FTZ / DAZ and rounding modes"});
+    options.add_option("", {"P,pareto", "Mark approximations that are slower and less accurate than another one. AXES is \"time\" or \"throughput\" and \"relative\" or \"ulp\", e.g. \"time:ulp\"", cxxopts::value<std::string>()});
+    options.add_option("", {"pareto-file", "Add the results to FILE and run the Pareto analysis on all results in it", cxxopts::value<std::string>()});
+    options.add_option("", {"plugin", "Load approximations from a shared library (see approx_plugin.h). Can be given multiple times", cxxopts::value<std::vector<std::string>>()});
+    options.add_option("", {"isa", "Also test the kernels compiled for all x86-64 ISA levels (v1 - v4) this CPU supports"});
+    options.add_option("", {"mca", "Disassemble the loop body of every approximation and predict its cost with llvm-mca for a comma-separated list of CPU models, e.g. \"skylake,znver3\"", cxxopts::value<std::string>()});
+    options.add_option("", {"fuzz", "Also check INPUTS random bit patterns and the edge cases of the input range per approximation against the reference", cxxopts::value<uint64_t>()});
+    options.add_option("", {"fuzz-ulp", "Fail fuzzed results with an error larger than N ULPs of the result type", cxxopts::value<double>()});
+    options.add_option("", {"fuzz-baseline", "Check fuzzed results against the max. errors recorded in FILE and record the approximations missing in it", cxxopts::value<std::string>()});
+    options.add_option("", {"fuzz-tolerance", "Factor on the max. errors of the baseline the fuzzer allows. Default is 2", cxxopts::value<double>()});
+    options.add_option("", {"v,validity", "Also search the longest input interval where the relative error is <= THRESHOLD", cxxopts::value<double>()});
     auto result = options.parse(argc, argv);
     // check if help was requested
     if (result.count("help"))
@@ -45,6 +99,168 @@ bool readArguments(int argc, char**& argv)
     {
         m_plotFormat = result["plot"].as<std::string>();
     }
+    if (result.count("plot-width"))
+    {
+        PlotSettings::width = result["plot-width"].as<unsigned>();
+        if (PlotSettings::width < 100)
+        {
+            std::cout << "Plot width must be >= 100 pixels!" << std::endl;
+            return false;
+        }
+    }
+    if (result.count("input"))
+    {
+        m_inputGenerator = result["input"].as<std::string>();
+        if (m_inputGenerator != "linear" && m_inputGenerator != "log" && m_inputGenerator != "binades" && m_inputGenerator != "random" && m_inputGenerator != "special" && m_inputGenerator != "denormals" && m_inputGenerator != "file")
+        {
+            std::cout << "Unknown input generator \"" << m_inputGenerator << "\"!" << std::endl;
+            return false;
+        }
+    }
+    if (result.count("seed"))
+    {
+        m_randomSeed = result["seed"].as<uint64_t>();
+    }
+    if (result.count("input-file"))
+    {
+        m_inputFile = result["input-file"].as<std::string>();
+    }
+    if (result.count("quick"))
+    {
+        m_samples = 1000;
+        TestSettings::minTime = 0.01;
+        TestSettings::maxTime = 0.1;
+        TestSettings::targetPrecision = 0.05;
+    }
+    if (result.count("samples"))
+    {
+        m_samples = result["samples"].as<uint64_t>();
+        if (m_samples < 2)
+        {
+            std::cout << "Number of samples must be >= 2!" << std::endl;
+            return false;
+        }
+    }
+    if (result.count("min-time"))
+    {
+        TestSettings::minTime = result["min-time"].as<double>();
+    }
+    if (result.count("max-time"))
+    {
+        TestSettings::maxTime = result["max-time"].as<double>();
+    }
+    if (TestSettings::minTime < 0 || TestSettings::maxTime < TestSettings::minTime)
+    {
+        std::cout << "Measurement times must be >= 0 and the maximum time >= the minimum time!" << std::endl;
+        return false;
+    }
+    if (result.count("orders"))
+    {
+        TestSettings::compareInputOrders = true;
+    }
+    if (result.count("buckets"))
+    {
+        TestSettings::bucketStatistics = true;
+    }
+    if (result.count("modes"))
+    {
+        if (!floatModesSupported())
+        {
+            std::cout << "Setting floating-point modes is not supported on this CPU!" << std::endl;
+            return false;
+        }
+        TestSettings::compareFloatModes = true;
+    }
+    if (result.count("pareto"))
+    {
+        const auto axes = result["pareto"].as<std::string>();
+        const auto separator = axes.find(':');
+        const auto speed = axes.substr(0, separator);
+        const auto error = separator != std::string::npos ? axes.substr(separator + 1) : "relative";
+        if ((speed != "time" && speed != "throughput") || (error != "relative" && error != "ulp"))
+        {
+            std::cout << "Unknown Pareto axes \"" << axes << "\"!" << std::endl;
+            return false;
+        }
+        ParetoSettings::enabled = true;
+        ParetoSettings::throughput = speed == "throughput";
+        ParetoSettings::ulpError = error == "ulp";
+    }
+    if (result.count("pareto-file"))
+    {
+        ParetoSettings::enabled = true;
+        ParetoSettings::fileName = result["pareto-file"].as<std::string>();
+    }
+    if (result.count("validity"))
+    {
+        TestSettings::validityThreshold = result["validity"].as<double>();
+        if (TestSettings::validityThreshold <= 0)
+        {
+            std::cout << "Validity threshold must be > 0!" << std::endl;
+            return false;
+        }
+    }
+    if (result.count("fuzz"))
+    {
+        TestSettings::fuzzInputs = result["fuzz"].as<uint64_t>();
+        TestSettings::fuzzSeed = m_randomSeed;
+    }
+    if (result.count("fuzz-ulp"))
+    {
+        TestSettings::fuzzMaxUlpError = result["fuzz-ulp"].as<double>();
+        if (TestSettings::fuzzMaxUlpError <= 0)
+        {
+            std::cout << "Fuzzing ULP error must be > 0!" << std::endl;
+            return false;
+        }
+    }
+    if (result.count("fuzz-baseline"))
+    {
+        m_fuzzBaselineFile = result["fuzz-baseline"].as<std::string>();
+        TestSettings::fuzzBaselines = readFuzzBaselines(m_fuzzBaselineFile);
+    }
+    if (result.count("fuzz-tolerance"))
+    {
+        TestSettings::fuzzTolerance = result["fuzz-tolerance"].as<double>();
+        if (TestSettings::fuzzTolerance < 1)
+        {
+            std::cout << "Fuzzing tolerance must be >= 1!" << std::endl;
+            return false;
+        }
+    }
+    if (result.count("plugin"))
+    {
+        for (const auto& fileName : result["plugin"].as<std::vector<std::string>>())
+        {
+            if (!loadPlugin(fileName, PluginSettings::kernels))
+            {
+                return false;
+            }
+        }
+    }
+    if (result.count("isa") && !loadIsaKernels(PluginSettings::kernels))
+    {
+        std::cout << "Failed to load the kernels for the ISA levels!" << std::endl;
+        return false;
+    }
+    if (result.count("mca"))
+    {
+        McaSettings::enabled = true;
+        std::istringstream cpus(result["mca"].as<std::string>());
+        std::string cpu;
+        while (std::getline(cpus, cpu, ','))
+        {
+            if (!cpu.empty())
+            {
+                McaSettings::cpus.push_back(cpu);
+            }
+        }
+    }
+    if (m_inputGenerator == "file" && !std::ifstream(m_inputFile))
+    {
+        std::cout << "Failed to open input file \"" << m_inputFile << "\"!" << std::endl;
+        return false;
+    }
     return true;
 }
 
@@ -52,29 +268,216 @@ void printUsage()
 {
     // 80 chars:  --------------------------------------------------------------------------------
     std::cout << "approx - Test transcendental function approximations" << std::endl;
-    std::cout << "Usage: approx (-h, -p FORMAT, -f FUNC)" << std::endl;
+    std::cout << "Usage: approx (-h, -p FORMAT, --plot-width PIXELS, -i GEN, -s SEED, --input-file FILE, -n SAMPLES, --min-time S, --max-time S, -q, -o, -m, -b, -v THRESHOLD, --fuzz INPUTS, --fuzz-ulp N, --fuzz-baseline FILE, --fuzz-tolerance F, -P AXES, --pareto-file FILE, --plugin FILE, --isa, --mca CPUS, -f FUNC)" << std::endl;
     std::cout << "-h: Print usage help." << std::endl;
     std::cout << "-f FUNC: Function to test." << std::endl;
-    std::cout << "FUNC can be \"expf\", \"log10f\", \"invsqrtf\", \"sqrtf\", \"sqrti\" or \"atan2f\"." << std::endl;
+    std::cout << "FUNC can be \"expf\", \"exp2f\", \"log2f\", \"powf\", \"log10f\", \"log10d\"," << std::endl;
+    std::cout << "\"tanhf\", \"sigmoidf\", \"erff\", \"cbrtf\", \"normalize3f\", \"sincosf\"," << std::endl;
+    std::cout << "\"invsqrtf\", \"invsqrtd\", \"recipf\", \"sqrtf\", \"sqrtfcompose\", \"sqrtd\"," << std::endl;
+    std::cout << "\"sqrti16\", \"sqrti\", \"sqrti64\", \"log2i\", \"log2i64\", \"log10i\", \"log10i64\"," << std::endl;
+    std::cout << "\"invsqrth\", \"exph\", \"logh\", \"invsqrtbf16\", \"expbf16\", \"logbf16\"," << std::endl;
+    std::cout << "\"sqrtq16\", \"invsqrtq16\", \"log2q15\", \"log10q15\", \"atan2q15\" or \"atan2f\"." << std::endl;
     std::cout << "-p FORMAT: Plot test results using GNUplot." << std::endl;
-    std::cout << "FORMAT is the result file format. Either \"pdf\" or \"html\"." << std::endl;
+    std::cout << "FORMAT is the result file format. Either \"pdf\" or \"html\", or \"report\" for an" << std::endl;
+    std::cout << "interactive HTML report with embedded data that does not need GNUplot." << std::endl;
+    std::cout << "--plot-width PIXELS: Width of the plot. Default is 1200. Curves are reduced to" << std::endl;
+    std::cout << "the minimum and maximum value per pixel, so plotting is fast for any sample count." << std::endl;
+    std::cout << "-i GEN: Input values to use instead of the default of the function." << std::endl;
+    std::cout << "GEN can be \"linear\", \"log\" (log-uniform), \"binades\" (same number of samples" << std::endl;
+    std::cout << "per power of two), \"random\" (uniform), \"special\" (0, denormals, inf, NaN etc.)," << std::endl;
+    std::cout << "\"denormals\" or \"file\" (read values from FILE). Only for functions with one argument." << std::endl;
+    std::cout << "-s SEED: Seed for random input values. Default is 42." << std::endl;
+    std::cout << "--input-file FILE: Text file with whitespace-separated input values." << std::endl;
+    std::cout << "-n SAMPLES: Number of input values. Default depends on FUNC, usually 10000." << std::endl;
+    std::cout << "--min-time S: Repeat every measurement for at least S seconds and until the time" << std::endl;
+    std::cout << "per call is precise to 1%. Default is 0.1s." << std::endl;
+    std::cout << "--max-time S: Stop every measurement after S seconds, even if the time per call" << std::endl;
+    std::cout << "is not precise enough yet. Default is 2s." << std::endl;
+    std::cout << "-q: Quick overview with 1000 samples and 0.01-0.1s per measurement (5% precision)." << std::endl;
+    std::cout << "-o: Also time functions with the input values sorted, shuffled and in alternating" << std::endl;
+    std::cout << "order (smallest, largest, 2nd smallest, ...) to show the cost of branches." << std::endl;
+    std::cout << "-m: Also time and check functions with FTZ / DAZ on and off and all rounding" << std::endl;
+    std::cout << "modes. Use with \"-i denormals\" to see the cost of denormals." << std::endl;
+    std::cout << "-b: Also list errors and execution time per binade [2^n, 2^(n+1)) of the input" << std::endl;
+    std::cout << "values (per bit length for integers). Plotted as heatmaps with \"-p\"." << std::endl;
+    std::cout << "-v THRESHOLD: Also search all float / double values for the longest interval" << std::endl;
+    std::cout << "where the relative error is <= THRESHOLD, e.g. 1e-3." << std::endl;
+    std::cout << "--fuzz INPUTS: Also check INPUTS random bit patterns from the input range and its" << std::endl;
+    std::cout << "edge cases against the reference, in scalar and batch variants. Non-finite" << std::endl;
+    std::cout << "results fail. Failing inputs are minimized and listed, and approx exits with -3." << std::endl;
+    std::cout << "Uses the seed of -s." << std::endl;
+    std::cout << "--fuzz-ulp N: The fuzzer also fails results with an error larger than N ULPs." << std::endl;
+    std::cout << "--fuzz-baseline FILE: The fuzzer also fails results with a relative and absolute" << std::endl;
+    std::cout << "error larger than the max. errors recorded in FILE times --fuzz-tolerance F" << std::endl;
+    std::cout << "(default 2). Approximations missing in FILE are added with their current errors." << std::endl;
+    std::cout << "-P AXES: Mark approximations that are both slower and less accurate than" << std::endl;
+    std::cout << "another one and list the Pareto frontier. AXES is SPEED:ERROR with SPEED" << std::endl;
+    std::cout << "\"time\" or \"throughput\" and ERROR \"relative\" or \"ulp\" (max. error)." << std::endl;
+    std::cout << "--pareto-file FILE: Add the results to FILE and compare them to all results in it," << std::endl;
+    std::cout << "e.g. of other functions or previous runs. Implies -P." << std::endl;
+    std::cout << "--plugin FILE: Load approximations from the shared library FILE and test them" << std::endl;
+    std::cout << "with the built-in ones. See approx_plugin.h. Can be given multiple times." << std::endl;
+    std::cout << "--isa: Also test the kernels compiled for the x86-64 ISA levels v1 (SSE2), v2" << std::endl;
+    std::cout << "(SSE4.2), v3 (AVX2 + FMA) and v4 (AVX-512) this CPU supports, side by side." << std::endl;
+    std::cout << "--mca CPUS: Disassemble the loop body of every approximation to result_mca/ and" << std::endl;
+    std::cout << "predict cycles, latency and port pressure with llvm-mca (if installed) for the" << std::endl;
+    std::cout << "comma-separated CPU models CPUS, e.g. \"skylake,znver3\". Added to the report." << std::endl;
     std::cout << "Example: approx -f sqrtf -p pdf" << std::endl;
 }
 
 // ----- main -------------------------------------------------------------------------------------
 
+/// @brief Return the number of samples selected with "-n" or "-q" or defaultSamples if none was selected.
+uint64_t sampleCount(uint64_t defaultSamples)
+{
+    return m_samples > 0 ? m_samples : defaultSamples;
+}
+
+/// @brief Return the input generator selected with "-i" or defaultGenerator if none was selected.
+/// 16-bit floating-point values are generated as float and converted. Functions with multiple arguments
+/// (e.g. atan2f) always use their default generator.
+template <typename T>
+std::function<std::vector<T>(const std::pair<T, T>&, uint64_t)> selectInputGenerator(std::function<std::vector<T>(const std::pair<T, T>&, uint64_t)> defaultGenerator)
+{
+    if (m_inputGenerator.empty())
+    {
+        return defaultGenerator;
+    }
+    if constexpr (std::is_integral<T>::value || (std::is_floating_point<T>::value && sizeof(T) >= sizeof(float)))
+    {
+        if (m_inputGenerator == "linear")
+        {
+            return generateLinearX<T>;
+        }
+        else if (m_inputGenerator == "log")
+        {
+            return generateLogX<T>;
+        }
+        else if (m_inputGenerator == "binades")
+        {
+            return generateBinadesX<T>;
+        }
+        else if (m_inputGenerator == "random")
+        {
+            return [](const std::pair<T, T>& range, uint64_t samples)
+            { return generateRandomX<T>(range, samples, m_randomSeed); };
+        }
+        else if (m_inputGenerator == "special")
+        {
+            return generateSpecialX<T>;
+        }
+        else if (m_inputGenerator == "denormals")
+        {
+            if constexpr (std::is_floating_point<T>::value)
+            {
+                return generateDenormalsX<T>;
+            }
+        }
+        else if (m_inputGenerator == "file")
+        {
+            return [](const std::pair<T, T>& /*range*/, uint64_t /*samples*/)
+            { return generateFromFileX<T>(m_inputFile); };
+        }
+    }
+    else if constexpr (sizeof(T) == sizeof(uint16_t))
+    {
+        // float denormals would all be converted to 0
+        if (m_inputGenerator != "denormals")
+        {
+            auto floatGenerator = selectInputGenerator<float>(nullptr);
+            return [floatGenerator](const std::pair<T, T>& range, uint64_t samples)
+            {
+                std::vector<T> values;
+                for (const auto& f : floatGenerator({static_cast<float>(range.first), static_cast<float>(range.second)}, samples))
+                {
+                    values.push_back(T(f));
+                }
+                return values;
+            };
+        }
+    }
+    std::cout << "Input generator \"" << m_inputGenerator << "\" not supported for " << m_approxFunc << ", using default" << std::endl;
+    return defaultGenerator;
+}
+
 template <typename ResultT>
-void output(const std::vector<ResultT>& results)
+void output(std::vector<ResultT>& results)
 {
+    // fail the run if the fuzzer found inputs with too large errors, e.g. after a compiler upgrade
+    for (const auto& r : results)
+    {
+        m_fuzzFailed = m_fuzzFailed || r.fuzzFailures > 0;
+    }
+    // record the errors of approximations without a baseline, so later runs are checked against them
+    if (!m_fuzzBaselineFile.empty())
+    {
+        std::size_t added = 0;
+        for (const auto& r : results)
+        {
+            const double relativeError = double(r.relativeErrors.maximum);
+            const double absoluteError = double(r.absoluteErrors.maximum);
+            // check the bits, because -ffast-math assumes there are no NaNs and inf in comparisons
+            uint64_t relativeBits;
+            uint64_t absoluteBits;
+            std::memcpy(&relativeBits, &relativeError, sizeof(relativeBits));
+            std::memcpy(&absoluteBits, &absoluteError, sizeof(absoluteBits));
+            const bool finite = ((relativeBits >> 52) & 0x7FF) != 0x7FF && ((absoluteBits >> 52) & 0x7FF) != 0x7FF;
+            if (r.fuzzInputs > 0 && finite && findFuzzBaseline(TestSettings::fuzzBaselines, r.suiteName, r.name) == nullptr)
+            {
+                TestSettings::fuzzBaselines.push_back({r.suiteName, r.name, relativeError, absoluteError});
+                ++added;
+            }
+        }
+        if (added > 0)
+        {
+            writeFuzzBaselines(m_fuzzBaselineFile, TestSettings::fuzzBaselines);
+            std::cout << "Added " << added << " approximations to the fuzzing baseline " << m_fuzzBaselineFile << std::endl;
+        }
+    }
+    // static analysis of the machine code, added to the report
+    if (McaSettings::enabled && !results.empty())
+    {
+        analyzeMachineCode(results);
+        printMachineCode(std::cout, results);
+    }
+    // mark dominated approximations before writing them to files
+    std::vector<ParetoPoint> paretoPoints;
+    if (ParetoSettings::enabled && !results.empty())
+    {
+        paretoPoints = paretoAnalysis(results);
+        std::cout << paretoPoints;
+    }
     // plot results to file using gnuplot
-    if (!m_plotFormat.empty() && !results.empty())
+    if (m_plotFormat == "report" && !results.empty())
+    {
+        report(results, "result.html");
+    }
+    else if (!m_plotFormat.empty() && !results.empty())
     {
         std::string plotFileName = m_plotFormat == "html" ? "result.svg" : "result.pdf";
+        std::string bucketPlotFileName;
+        if (!results.front().buckets.empty())
+        {
+            bucketPlotFileName = m_plotFormat == "html" ? "result_buckets.svg" : "result_buckets.pdf";
+        }
+        std::string paretoPlotFileName;
+        if (!paretoPoints.empty())
+        {
+            paretoPlotFileName = m_plotFormat == "html" ? "result_pareto.svg" : "result_pareto.pdf";
+        }
         if (m_plotFormat == "html")
         {
-            html(results, "result.html", plotFileName);
+            html(results, "result.html", plotFileName, bucketPlotFileName, paretoPlotFileName);
         }
         plot(results, plotFileName);
+        if (!bucketPlotFileName.empty())
+        {
+            plotBuckets(results, bucketPlotFileName);
+        }
+        if (!paretoPlotFileName.empty())
+        {
+            plotPareto(paretoPoints, paretoPlotFileName);
+        }
     }
 }
 
@@ -95,41 +498,306 @@ int main(int argc, char** argv)
     {
         ExpfTest expfTest(std::make_pair(-88, 88), 10000);
         auto results = expfTest.runTests();
+        expfTest.runPlugins(m_approxFunc, results);
         std::cout << results;
         output(results);
     } else */
     if (m_approxFunc == "log10f")
     {
-        Log10Test log10Test(generateLinearX<Log10Test::input_t>, {0, 65535}, 10000);
+        Log10Test log10Test(selectInputGenerator<Log10Test::input_t>(generateLinearX<Log10Test::input_t>), {0, 65535}, sampleCount(10000));
         auto results = log10Test.runTests();
+        log10Test.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "log2f")
+    {
+        Log2fTest log2Test(selectInputGenerator<Log2fTest::input_t>(generateLinearX<Log2fTest::input_t>), {0, 65535}, sampleCount(10000));
+        auto results = log2Test.runTests();
+        log2Test.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "exp2f")
+    {
+        Exp2fTest exp2Test(selectInputGenerator<Exp2fTest::input_t>(generateLinearX<Exp2fTest::input_t>), {-126, 127}, sampleCount(10000));
+        auto results = exp2Test.runTests();
+        exp2Test.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "powf")
+    {
+        PowfTest powTest(selectInputGenerator<PowfTest::input_t>([](const PowfTest::input_range_t& range, uint64_t samples)
+                                                                 { return generateRandomXY<PowfTest::input_t>(range, samples, m_randomSeed); }),
+                         {{0.001F, -4}, {100, 4}}, sampleCount(10000));
+        auto results = powTest.runTests();
+        powTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "tanhf")
+    {
+        // dense samples around 0 and where tanh saturates
+        TanhfTest tanhTest(selectInputGenerator<TanhfTest::input_t>([](const TanhfTest::input_range_t& range, uint64_t samples)
+                                                                    { return generateKneesX<float>(range, samples, {-3, 0, 3}, 1); }),
+                           {-10, 10}, sampleCount(10000));
+        auto results = tanhTest.runTests();
+        tanhTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "sigmoidf")
+    {
+        SigmoidfTest sigmoidTest(selectInputGenerator<SigmoidfTest::input_t>([](const SigmoidfTest::input_range_t& range, uint64_t samples)
+                                                                             { return generateKneesX<float>(range, samples, {-6, 0, 6}, 2); }),
+                                 {-20, 20}, sampleCount(10000));
+        auto results = sigmoidTest.runTests();
+        sigmoidTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "erff")
+    {
+        ErffTest erfTest(selectInputGenerator<ErffTest::input_t>([](const ErffTest::input_range_t& range, uint64_t samples)
+                                                                 { return generateKneesX<float>(range, samples, {-2, 0, 2}, 1); }),
+                         {-5, 5}, sampleCount(10000));
+        auto results = erfTest.runTests();
+        erfTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "log10d")
+    {
+        Log10dTest log10Test(selectInputGenerator<Log10dTest::input_t>(generateLinearX<Log10dTest::input_t>), {0, 65535}, sampleCount(10000));
+        auto results = log10Test.runTests();
+        log10Test.runPlugins(m_approxFunc, results);
         std::cout << results;
         output(results);
     }
     else if (m_approxFunc == "invsqrtf")
     {
-        InvSqrtfTest invSqrtTest(generateLinearX<InvSqrtfTest::input_t>, {0, 2}, 10000);
+        InvSqrtfTest invSqrtTest(selectInputGenerator<InvSqrtfTest::input_t>(generateLinearX<InvSqrtfTest::input_t>), {0, 2}, sampleCount(10000));
+        auto results = invSqrtTest.runTests();
+        invSqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "invsqrtd")
+    {
+        InvSqrtdTest invSqrtTest(selectInputGenerator<InvSqrtdTest::input_t>(generateLinearX<InvSqrtdTest::input_t>), {1e-300, 2}, sampleCount(10000));
         auto results = invSqrtTest.runTests();
+        invSqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "sincosf")
+    {
+        SinCosfTest sinCosTest(selectInputGenerator<SinCosfTest::input_t>(generateLinearX<SinCosfTest::input_t>), {-100, 100}, sampleCount(10000));
+        auto results = sinCosTest.runTests();
+        sinCosTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "recipf")
+    {
+        RecipfTest recipTest(selectInputGenerator<RecipfTest::input_t>(generateLinearX<RecipfTest::input_t>), {0.001F, 65535}, sampleCount(10000));
+        auto results = recipTest.runTests();
+        recipTest.runPlugins(m_approxFunc, results);
         std::cout << results;
         output(results);
     }
     else if (m_approxFunc == "sqrtf")
     {
-        SqrtfTest sqrtTest(generateLinearX<SqrtfTest::input_t>, {0, 65535}, 10000);
+        SqrtfTest sqrtTest(selectInputGenerator<SqrtfTest::input_t>(generateLinearX<SqrtfTest::input_t>), {0, 65535}, sampleCount(10000));
         auto results = sqrtTest.runTests();
+        sqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "cbrtf")
+    {
+        CbrtfTest cbrtTest(selectInputGenerator<CbrtfTest::input_t>(generateLinearX<CbrtfTest::input_t>), {0, 65535}, sampleCount(10000));
+        auto results = cbrtTest.runTests();
+        cbrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "normalize3f")
+    {
+        NormalizefTest normalizeTest(selectInputGenerator<NormalizefTest::input_t>([](const NormalizefTest::input_range_t& range, uint64_t samples)
+                                                                                   { return generateRandomXYZ<NormalizefTest::input_t>(range, samples, m_randomSeed); }),
+                                     {{-100, -100, -100}, {100, 100, 100}}, sampleCount(10000));
+        auto results = normalizeTest.runTests();
+        normalizeTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "sqrtfcompose")
+    {
+        SqrtfComposeTest sqrtTest(selectInputGenerator<SqrtfComposeTest::input_t>(generateLinearX<SqrtfComposeTest::input_t>), {1e-30F, 65535}, sampleCount(10000));
+        auto results = sqrtTest.runTests();
+        sqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "sqrtd")
+    {
+        SqrtdTest sqrtTest(selectInputGenerator<SqrtdTest::input_t>(generateLinearX<SqrtdTest::input_t>), {1e-300, 65535}, sampleCount(10000));
+        auto results = sqrtTest.runTests();
+        sqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "sqrti16")
+    {
+        Sqrti16Test sqrtTest(selectInputGenerator<Sqrti16Test::input_t>(generateLinearX<Sqrti16Test::input_t>), {0, 0xFFFF}, sampleCount(10000));
+        auto results = sqrtTest.runTests();
+        sqrtTest.runPlugins(m_approxFunc, results);
         std::cout << results;
         output(results);
     }
     else if (m_approxFunc == "sqrti")
     {
-        SqrtiTest sqrtTest(generateLinearX<SqrtiTest::input_t>, {0, 0xFFFFFFFF}, 10000);
+        SqrtiTest sqrtTest(selectInputGenerator<SqrtiTest::input_t>(generateLinearX<SqrtiTest::input_t>), {0, 0xFFFFFFFF}, sampleCount(10000));
+        auto results = sqrtTest.runTests();
+        sqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "sqrti64")
+    {
+        Sqrti64Test sqrtTest(selectInputGenerator<Sqrti64Test::input_t>(generateLinearX<Sqrti64Test::input_t>), {0, 0xFFFFFFFFFFFFFFFF}, sampleCount(10000));
+        auto results = sqrtTest.runTests();
+        sqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "log2i")
+    {
+        Log2iTest log2Test(selectInputGenerator<Log2iTest::input_t>(generatePowerOfTwoBoundariesX<Log2iTest::input_t>), {1, 0xFFFFFFFF}, sampleCount(10000));
+        auto results = log2Test.runTests();
+        log2Test.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "log2i64")
+    {
+        Log2i64Test log2Test(selectInputGenerator<Log2i64Test::input_t>(generatePowerOfTwoBoundariesX<Log2i64Test::input_t>), {1, 0xFFFFFFFFFFFFFFFF}, sampleCount(10000));
+        auto results = log2Test.runTests();
+        log2Test.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "log10i")
+    {
+        Log10iTest log10Test(selectInputGenerator<Log10iTest::input_t>(generatePowerOfTwoBoundariesX<Log10iTest::input_t>), {1, 0xFFFFFFFF}, sampleCount(10000));
+        auto results = log10Test.runTests();
+        log10Test.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "log10i64")
+    {
+        Log10i64Test log10Test(selectInputGenerator<Log10i64Test::input_t>(generatePowerOfTwoBoundariesX<Log10i64Test::input_t>), {1, 0xFFFFFFFFFFFFFFFF}, sampleCount(10000));
+        auto results = log10Test.runTests();
+        log10Test.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "invsqrth")
+    {
+        InvSqrthTest invSqrtTest(selectInputGenerator<InvSqrthTest::input_t>(generateExhaustive16X<InvSqrthTest::input_t>), {half_t(0.0F), half_t(65504.0F)}, sampleCount(10000));
+        auto results = invSqrtTest.runTests();
+        invSqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "exph")
+    {
+        ExphTest expTest(selectInputGenerator<ExphTest::input_t>(generateExhaustive16X<ExphTest::input_t>), {half_t(-9.7F), half_t(11.08F)}, sampleCount(10000));
+        auto results = expTest.runTests();
+        expTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "logh")
+    {
+        LoghTest logTest(selectInputGenerator<LoghTest::input_t>(generateExhaustive16X<LoghTest::input_t>), {half_t(0.0F), half_t(65504.0F)}, sampleCount(10000));
+        auto results = logTest.runTests();
+        logTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "invsqrtbf16")
+    {
+        InvSqrtbf16Test invSqrtTest(selectInputGenerator<InvSqrtbf16Test::input_t>(generateExhaustive16X<InvSqrtbf16Test::input_t>), {bfloat16(0.0F), bfloat16(1e37F)}, sampleCount(10000));
+        auto results = invSqrtTest.runTests();
+        invSqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "expbf16")
+    {
+        Expbf16Test expTest(selectInputGenerator<Expbf16Test::input_t>(generateExhaustive16X<Expbf16Test::input_t>), {bfloat16(-87.0F), bfloat16(88.0F)}, sampleCount(10000));
+        auto results = expTest.runTests();
+        expTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "logbf16")
+    {
+        Logbf16Test logTest(selectInputGenerator<Logbf16Test::input_t>(generateExhaustive16X<Logbf16Test::input_t>), {bfloat16(0.0F), bfloat16(3e38F)}, sampleCount(10000));
+        auto results = logTest.runTests();
+        logTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "sqrtq16")
+    {
+        SqrtQ16Test sqrtTest(selectInputGenerator<SqrtQ16Test::input_t>(generateOctavesX<SqrtQ16Test::input_t>), {0, 0x3FFFFFFF}, sampleCount(10000));
         auto results = sqrtTest.runTests();
+        sqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "invsqrtq16")
+    {
+        InvSqrtQ16Test invSqrtTest(selectInputGenerator<InvSqrtQ16Test::input_t>(generateOctavesX<InvSqrtQ16Test::input_t>), {1, 0x7FFFFFFF}, sampleCount(10000));
+        auto results = invSqrtTest.runTests();
+        invSqrtTest.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "log2q15")
+    {
+        Log2Q15Test log2Test(selectInputGenerator<Log2Q15Test::input_t>(generateOctavesX<Log2Q15Test::input_t>), {1, 0x7FFF}, sampleCount(10000));
+        auto results = log2Test.runTests();
+        log2Test.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "log10q15")
+    {
+        Log10Q15Test log10Test(selectInputGenerator<Log10Q15Test::input_t>(generateOctavesX<Log10Q15Test::input_t>), {1, 0x7FFF}, sampleCount(10000));
+        auto results = log10Test.runTests();
+        log10Test.runPlugins(m_approxFunc, results);
+        std::cout << results;
+        output(results);
+    }
+    else if (m_approxFunc == "atan2q15")
+    {
+        Atan2Q15Test atan2Test(selectInputGenerator<Atan2Q15Test::input_t>(generateCirclesXY<Atan2Q15Test::input_t>), {{-0x7FFF, -0x7FFF}, {0x7FFF, 0x7FFF}}, sampleCount(10000));
+        auto results = atan2Test.runTests();
+        atan2Test.runPlugins(m_approxFunc, results);
         std::cout << results;
         output(results);
     }
     /*else if (m_approxFunc == "atan2f")
     {
-        Atan2fTest atan2Test(generateCirclesXY<Atan2fTest::input_t>, {{-65535, -65535}, {65535, 65535}}, 10000);
+        Atan2fTest atan2Test(selectInputGenerator<Atan2fTest::input_t>(generateCirclesXY<Atan2fTest::input_t>), {{-65535, -65535}, {65535, 65535}}, sampleCount(10000));
         auto results = atan2Test.runTests();
+        atan2Test.runPlugins(m_approxFunc, results);
         std::cout << results;
         output(results);
     }*/
@@ -138,5 +806,5 @@ int main(int argc, char** argv)
         std::cout << "Unsupported function \"" << m_approxFunc << "\"" << std::endl;
         return -2;
     }
-    return 0;
+    return m_fuzzFailed ? -3 : 0;
 }
@@ -0,0 +1,493 @@
+#pragma once
+
+// Static instruction-level cost of the approximations: The machine code of every approximation is disassembled with objdump
+// from the binary it was loaded from (approx itself or a plugin) and its loop body is analyzed with llvm-mca for a list of
+// CPU models. llvm-mca predicts the cycles per iteration in a loop of independent calls, the latency of one iteration and
+// the pressure on the execution ports, so it shows if e.g. a polynomial or a division is the bottleneck of a kernel without
+// running it on that CPU. The prediction only covers the instructions, not cache misses, branch mispredictions or calls to
+// other functions. Kernels are analyzed as compiled out-of-line, while the benchmark loop may inline them.
+// The loop body of a scalar function is the whole function, for batch functions it is the loop in the function using the
+// widest vector registers, so one iteration can process several values.
+// See: https://llvm.org/docs/CommandGuide/llvm-mca.html
+
+#include "result.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#include <sys/wait.h>
+#define APPROX_HAVE_MCA
+#endif
+
+// tools used for the analysis. Set by CMake if found, otherwise they are searched in PATH
+#ifndef APPROX_OBJDUMP
+#define APPROX_OBJDUMP "objdump"
+#endif
+#ifndef APPROX_LLVM_MCA
+#define APPROX_LLVM_MCA "llvm-mca"
+#endif
+
+// number of iterations llvm-mca simulates to predict the cycles per iteration
+#define MCA_ITERATIONS 100
+
+/// @brief Settings for the static analysis, set from the command line.
+struct McaSettings
+{
+    static inline bool enabled = false; // disassemble and analyze the approximations
+    static inline std::vector<std::string> cpus; // CPU models llvm-mca predicts the costs for, e.g. "skylake" or "znver3"
+    static inline std::string directory = "result_mca"; // the disassembled loop bodies are written to this directory
+};
+
+/// @brief Function disassembled by objdump.
+struct DisassembledFunction
+{
+    uint64_t address = 0; // address of the first instruction in the file
+    std::string name; // demangled name, e.g. "sqrtf_9(float)"
+    std::vector<std::pair<uint64_t, std::string>> instructions; // address and text of every instruction in AT&T syntax
+};
+
+/// @brief Quote a string for the shell.
+inline std::string shellQuote(const std::string& s)
+{
+    std::string quoted = "'";
+    for (const char c : s)
+    {
+        quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+    }
+    return quoted + "'";
+}
+
+/// @brief Run a shell command and return what it printed to stdout and stderr.
+/// @param exitCode Set to the exit code of the command, 127 if it was not found or -1 if it could not be run.
+inline std::string runCommand(const std::string& command, int& exitCode)
+{
+    std::string output;
+    exitCode = -1;
+#if defined(APPROX_HAVE_MCA)
+    FILE* pipe = popen((command + " 2>&1").c_str(), "r");
+    if (pipe == nullptr)
+    {
+        return output;
+    }
+    char buffer[4096];
+    std::size_t size;
+    while ((size = std::fread(buffer, 1, sizeof(buffer), pipe)) > 0)
+    {
+        output.append(buffer, size);
+    }
+    const int status = pclose(pipe);
+    exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#else
+    (void)command;
+#endif
+    return output;
+}
+
+inline bool isHexNumber(const std::string& s)
+{
+    return !s.empty() && s.find_first_not_of("0123456789abcdef") == std::string::npos;
+}
+
+inline std::string trimWhitespace(const std::string& s)
+{
+    const auto first = s.find_first_not_of(" \t");
+    return first == std::string::npos ? std::string() : s.substr(first, s.find_last_not_of(" \t") - first + 1);
+}
+
+/// @brief Disassemble all functions of a binary. The result is cached, so every file is only disassembled once.
+/// Prints an error and returns no functions if objdump fails.
+inline const std::vector<DisassembledFunction>& disassemble(const std::string& fileName)
+{
+    static std::map<std::string, std::vector<DisassembledFunction>> cache;
+    auto cached = cache.find(fileName);
+    if (cached != cache.end())
+    {
+        return cached->second;
+    }
+    auto& functions = cache[fileName];
+    int exitCode;
+    const auto output = runCommand(std::string(APPROX_OBJDUMP) + " -d -C -w --no-show-raw-insn " + shellQuote(fileName), exitCode);
+    if (exitCode != 0)
+    {
+        std::cout << "Failed to disassemble \"" << fileName << "\" with " << APPROX_OBJDUMP << ": " << output.substr(0, output.find('\n')) << std::endl;
+        return functions;
+    }
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        const auto separator = line.find(':');
+        if (separator == std::string::npos)
+        {
+            continue;
+        }
+        // function: "0000000000001eb0 <sqrtf_9(float)>:"
+        const auto nameStart = line.find(" <");
+        if (line.size() > 2 && line.compare(line.size() - 2, 2, ">:") == 0 && nameStart != std::string::npos && isHexNumber(line.substr(0, nameStart)))
+        {
+            DisassembledFunction function;
+            function.address = std::stoull(line.substr(0, nameStart), nullptr, 16);
+            function.name = line.substr(nameStart + 2, line.size() - nameStart - 4);
+            functions.push_back(function);
+            continue;
+        }
+        // instruction: "    1eb4:\tvmovss 0x4a40(%rip),%xmm2        # 91a0 <Exp2fPoly5+0x30>"
+        const auto address = trimWhitespace(line.substr(0, separator));
+        if (functions.empty() || !isHexNumber(address))
+        {
+            continue;
+        }
+        auto text = line.substr(separator + 1);
+        // remove the comment and the symbol of the target address, neither can be assembled
+        text = text.substr(0, text.find('#'));
+        text = trimWhitespace(text.substr(0, text.find('<')));
+        if (!text.empty())
+        {
+            functions.back().instructions.emplace_back(std::stoull(address, nullptr, 16), text);
+        }
+    }
+    return functions;
+}
+
+/// @brief Find the binary containing the code at address and the address of the code in it.
+/// @return False if the address does not belong to a loaded binary.
+inline bool findBinary(const void* address, std::string& fileName, uint64_t& fileAddress)
+{
+#if defined(APPROX_HAVE_MCA)
+    Dl_info info;
+    Dl_info mainInfo;
+    if (dladdr(address, &info) == 0 || info.dli_fname == nullptr || dladdr(reinterpret_cast<const void*>(&findBinary), &mainInfo) == 0)
+    {
+        return false;
+    }
+    fileName = info.dli_fname;
+    if (info.dli_fbase == mainInfo.dli_fbase)
+    {
+        // the name of the executable is argv[0], which may not be a path
+        std::error_code error;
+        const auto exe = std::filesystem::read_symlink("/proc/self/exe", error);
+        if (!error)
+        {
+            fileName = exe.string();
+        }
+    }
+    // position independent binaries start at address 0 in the file
+    fileAddress = uint64_t(reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(info.dli_fbase));
+    return true;
+#else
+    (void)address;
+    (void)fileName;
+    (void)fileAddress;
+    return false;
+#endif
+}
+
+/// @brief Get the direct target of a jump or call instruction, e.g. "jae 4728". Returns false for other instructions and
+/// indirect jumps or calls, e.g. "call *%rax".
+inline bool branchTarget(const std::string& instruction, std::string& mnemonic, uint64_t& target)
+{
+    const auto space = instruction.find_first_of(" \t");
+    mnemonic = instruction.substr(0, space);
+    const auto operand = space != std::string::npos ? trimWhitespace(instruction.substr(space)) : std::string();
+    if ((mnemonic[0] != 'j' && mnemonic != "call") || !isHexNumber(operand))
+    {
+        return false;
+    }
+    target = std::stoull(operand, nullptr, 16);
+    return true;
+}
+
+/// @brief Width of the widest vector registers an instruction uses: 3 for zmm (AVX-512), 2 for ymm (AVX), 1 otherwise.
+inline int registerWidth(const std::string& instruction)
+{
+    return instruction.find("%zmm") != std::string::npos ? 3 : (instruction.find("%ymm") != std::string::npos ? 2 : 1);
+}
+
+/// @brief Extract the loop body of a function as assembly llvm-mca can read. Returns the innermost loop using the widest
+/// vector registers and with the most instructions, or the whole function if it has no loop.
+/// Jump targets are replaced with labels, padding and the return instruction are removed.
+inline std::vector<std::string> loopBody(const DisassembledFunction& function, StaticAnalysis& analysis)
+{
+    const auto& instructions = function.instructions;
+    std::size_t first = 0;
+    std::size_t last = instructions.empty() ? 0 : instructions.size() - 1;
+    int bestWidth = 0;
+    std::size_t bestSize = 0;
+    std::string mnemonic;
+    uint64_t target;
+    for (std::size_t i = 0; i < instructions.size(); ++i)
+    {
+        // a backward jump inside the function ends a loop
+        if (branchTarget(instructions[i].second, mnemonic, target) && mnemonic != "call" && target >= function.address && target <= instructions[i].first)
+        {
+            std::size_t start = i;
+            while (start > 0 && instructions[start].first > target)
+            {
+                --start;
+            }
+            int width = 0;
+            for (std::size_t j = start; j <= i; ++j)
+            {
+                width = std::max(width, registerWidth(instructions[j].second));
+            }
+            const std::size_t size = i - start + 1;
+            if (width > bestWidth || (width == bestWidth && size > bestSize))
+            {
+                first = start;
+                last = i;
+                bestWidth = width;
+                bestSize = size;
+            }
+        }
+    }
+    analysis.isLoop = bestSize > 0;
+    // labels for the jump targets in the loop body
+    std::vector<uint64_t> labels;
+    for (std::size_t i = first; i <= last && i < instructions.size(); ++i)
+    {
+        if (branchTarget(instructions[i].second, mnemonic, target))
+        {
+            labels.push_back(target);
+        }
+    }
+    std::vector<std::string> body;
+    if (!analysis.isLoop)
+    {
+        // the result of a function is in the register of its argument (x86-64 System V ABI), so llvm-mca would make every
+        // iteration wait for the previous one. the benchmark calls are independent, so break the dependency with zero idioms
+        body.push_back("# new argument, independent of the previous iteration");
+        body.push_back("xorps %xmm0,%xmm0");
+        body.push_back("xor %edi,%edi");
+    }
+    for (std::size_t i = first; i <= last && i < instructions.size(); ++i)
+    {
+        const auto& instruction = instructions[i].second;
+        if (std::find(labels.cbegin(), labels.cend(), instructions[i].first) != labels.cend())
+        {
+            std::ostringstream label;
+            label << ".L" << std::hex << instructions[i].first << ':';
+            body.push_back(label.str());
+        }
+        if (instruction.find("nop") != std::string::npos || instruction.rfind("ret", 0) == 0 || instruction.rfind("endbr", 0) == 0 ||
+            instruction.rfind("int3", 0) == 0 || instruction.rfind("(bad)", 0) == 0)
+        {
+            continue;
+        }
+        if (branchTarget(instruction, mnemonic, target))
+        {
+            analysis.hasCalls = analysis.hasCalls || mnemonic == "call";
+            std::ostringstream branch;
+            branch << mnemonic << " .L" << std::hex << target;
+            body.push_back(branch.str());
+        }
+        else
+        {
+            analysis.hasCalls = analysis.hasCalls || instruction.rfind("call", 0) == 0;
+            body.push_back(instruction);
+        }
+        ++analysis.instructions;
+    }
+    return body;
+}
+
+/// @brief Get the number after "key:" in the output of llvm-mca, e.g. "Total Cycles:      405". Returns 0 if not found.
+inline double mcaValue(const std::string& output, const std::string& key)
+{
+    const auto position = ("\n" + output).find("\n" + key + ":");
+    return position != std::string::npos ? std::strtod(output.c_str() + position + key.size() + 1, nullptr) : 0;
+}
+
+/// @brief Run llvm-mca on an assembly file for a CPU model and read the predicted costs from its output.
+inline StaticCost runMca(const std::string& asmFileName, const std::string& cpu)
+{
+    StaticCost cost;
+    cost.cpu = cpu;
+    const std::string command = std::string(APPROX_LLVM_MCA) + " -mcpu=" + shellQuote(cpu) + " " + shellQuote(asmFileName);
+    int exitCode;
+    const auto output = runCommand(command + " -iterations=" + std::to_string(MCA_ITERATIONS), exitCode);
+    if (output.find("not a recognized processor") != std::string::npos)
+    {
+        cost.error = "unknown CPU model";
+        return cost;
+    }
+    if (exitCode != 0)
+    {
+        // e.g. "error: found an unsupported instruction in the input assembly sequence." + "note: instruction: vaddps ..."
+        const auto note = output.find("note: instruction:");
+        cost.error = note != std::string::npos ? "unsupported instruction " + trimWhitespace(output.substr(note + 18, output.find('\n', note) - note - 18))
+                                               : trimWhitespace(output.substr(0, output.find('\n')));
+        return cost;
+    }
+    cost.cyclesPerIteration = mcaValue(output, "Total Cycles") / mcaValue(output, "Iterations");
+    cost.ipc = mcaValue(output, "IPC");
+    // "Resources:" lists "[2]   - SKLPort0", "Resource pressure per iteration:" the header "[0] [1] ..." and the cycles per resource
+    std::vector<std::string> resources;
+    const auto resourcesStart = output.find("\nResources:");
+    std::istringstream lines(resourcesStart != std::string::npos ? output.substr(resourcesStart + 1) : std::string());
+    std::string line;
+    std::getline(lines, line);
+    while (std::getline(lines, line) && !line.empty())
+    {
+        const auto dash = line.find("- ");
+        resources.push_back(dash != std::string::npos ? trimWhitespace(line.substr(dash + 2)) : line);
+    }
+    const auto pressureStart = output.find("Resource pressure per iteration:");
+    if (pressureStart != std::string::npos && !resources.empty())
+    {
+        std::istringstream pressureLines(output.substr(pressureStart));
+        std::getline(pressureLines, line);
+        std::getline(pressureLines, line);
+        std::getline(pressureLines, line);
+        std::istringstream pressures(line);
+        std::string pressure;
+        for (std::size_t i = 0; pressures >> pressure && i < resources.size(); ++i)
+        {
+            // "-" is no pressure
+            const double cycles = pressure == "-" ? 0 : std::strtod(pressure.c_str(), nullptr);
+            if (cycles > cost.bottleneckPressure)
+            {
+                cost.bottleneck = resources[i];
+                cost.bottleneckPressure = cycles;
+            }
+        }
+    }
+    // the latency is the time a single iteration needs from start to end
+    cost.latencyCycles = mcaValue(runCommand(command + " -iterations=1", exitCode), "Total Cycles");
+    return cost;
+}
+
+/// @brief Disassemble the loop bodies of all results with a known function, write them to McaSettings::directory and predict
+/// their costs for all CPU models in McaSettings::cpus with llvm-mca, if it is installed.
+template <typename ResultT>
+void analyzeMachineCode(std::vector<ResultT>& rs)
+{
+    int exitCode;
+    runCommand(std::string(APPROX_LLVM_MCA) + " --version", exitCode);
+    const bool haveMca = exitCode == 0;
+    if (!haveMca)
+    {
+        std::cout << "llvm-mca (" << APPROX_LLVM_MCA << ") not found, only writing the disassembled loop bodies" << std::endl;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(McaSettings::directory, error);
+    for (auto& r : rs)
+    {
+        std::string fileName;
+        uint64_t fileAddress;
+        if (r.kernelAddress == nullptr || !findBinary(r.kernelAddress, fileName, fileAddress))
+        {
+            continue;
+        }
+        const auto& functions = disassemble(fileName);
+        // binaries that are not position independent are loaded at the addresses in the file
+        const uint64_t absoluteAddress = uint64_t(reinterpret_cast<uintptr_t>(r.kernelAddress));
+        auto function = std::find_if(functions.cbegin(), functions.cend(), [fileAddress, absoluteAddress](const DisassembledFunction& f)
+                                     { return f.address == fileAddress || f.address == absoluteAddress; });
+        if (function == functions.cend())
+        {
+            std::cout << "Machine code of " << r.name << " not found in \"" << fileName << "\"" << std::endl;
+            continue;
+        }
+        // follow wrappers that only jump to another function, e.g. the batch functions of plugins
+        std::string mnemonic;
+        uint64_t target;
+        while (function->instructions.size() >= 1 && branchTarget(function->instructions.front().second, mnemonic, target) && mnemonic == "jmp")
+        {
+            auto targetFunction = std::find_if(functions.cbegin(), functions.cend(), [target](const DisassembledFunction& f)
+                                               { return f.address == target; });
+            if (targetFunction == functions.cend() || targetFunction == function)
+            {
+                break;
+            }
+            function = targetFunction;
+        }
+        auto& analysis = r.staticAnalysis;
+        analysis.function = function->name;
+        const auto body = loopBody(*function, analysis);
+        // e.g. "result_mca/sqrtf_9.s" or "result_mca/x86-64-v3_recipf_7.s". the name without the return type of templates
+        std::string name;
+        int templateDepth = 0;
+        for (const char c : function->name)
+        {
+            templateDepth += c == '<' ? 1 : (c == '>' ? -1 : 0);
+            if (templateDepth == 0 && c == '(')
+            {
+                break;
+            }
+            name += c;
+        }
+        const auto space = name.rfind(' ', name.find('<'));
+        name = name.substr(space != std::string::npos ? space + 1 : 0);
+        const auto labelEnd = r.name.rfind(':');
+        name = (labelEnd != std::string::npos ? r.name.substr(0, labelEnd) + "_" : std::string()) + name;
+        std::replace_if(name.begin(), name.end(), [](char c)
+                        { return !std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_'; },
+                        '_');
+        name.erase(std::unique(name.begin(), name.end(), [](char a, char b)
+                               { return a == '_' && b == '_'; }),
+                   name.end());
+        name.erase(name.find_last_not_of('_') + 1);
+        analysis.asmFileName = (std::filesystem::path(McaSettings::directory) / (name + ".s")).string();
+        std::ofstream asmFile(analysis.asmFileName);
+        asmFile << "# " << r.name << " - " << r.description << std::endl;
+        asmFile << "# " << (analysis.isLoop ? "loop in " : "") << function->name << " in " << fileName << std::endl;
+        for (const auto& line : body)
+        {
+            asmFile << line << std::endl;
+        }
+        asmFile.close();
+        for (const auto& cpu : McaSettings::cpus)
+        {
+            if (!haveMca)
+            {
+                break;
+            }
+            analysis.costs.push_back(runMca(analysis.asmFileName, cpu));
+        }
+    }
+}
+
+/// @brief Print the instruction counts and predicted costs of the results next to the measured time per call.
+template <typename ResultT>
+void printMachineCode(std::ostream& os, const std::vector<ResultT>& rs)
+{
+    os << "Static analysis (" << MCA_ITERATIONS << " iterations of the loop body, cycles / iteration, latency of one iteration, busiest resource):" << std::endl;
+    for (const auto& r : rs)
+    {
+        const auto& analysis = r.staticAnalysis;
+        if (analysis.function.empty())
+        {
+            os << "  " << r.name << " - " << r.description << ": machine code not found" << std::endl;
+            continue;
+        }
+        os << "  " << r.name << " - " << r.description << ": " << analysis.instructions << " instructions";
+        os << (analysis.isLoop ? " in a loop" : "") << " (" << analysis.asmFileName << "), measured " << r.nsPerCall() << " ns / call";
+        os << (analysis.hasCalls ? ", calls other functions, which llvm-mca does not model" : "") << std::endl;
+        for (const auto& cost : analysis.costs)
+        {
+            os << "    " << cost.cpu << ": ";
+            if (!cost.error.empty())
+            {
+                os << cost.error << std::endl;
+            }
+            else
+            {
+                os << cost.cyclesPerIteration << " cycles, latency " << cost.latencyCycles << " cycles, IPC " << cost.ipc;
+                os << ", " << cost.bottleneck << " " << cost.bottleneckPressure << " cycles" << std::endl;
+            }
+        }
+    }
+}
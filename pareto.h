@@ -0,0 +1,224 @@
+#pragma once
+
+// Speed vs. accuracy Pareto analysis: An approximation is dominated if another one is at least as fast and as accurate
+// and better in one of the two. The approximations that are not dominated form the Pareto frontier, all others can be dropped.
+// Points can be collected from several runs in a file, so approximations of different suites (e.g. sqrtf and sqrtfcompose)
+// and scalar / SIMD variants can be compared with each other. Only compare times measured on the same machine.
+// Speed is the time per call in the benchmark loop. Calls are independent, so this is the reciprocal throughput, not the latency.
+// Times that differ by less than their combined uncertainty are ties. Times that are not clearly above the baseline (see
+// nsPerCallUncertainty() in result.h) can not be compared at all, so these points are left out of the analysis.
+// See: https://en.wikipedia.org/wiki/Pareto_front
+
+#include "result.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// @brief Settings for the Pareto analysis, set from the command line.
+struct ParetoSettings
+{
+    static inline bool enabled = false; // run the Pareto analysis
+    static inline bool throughput = false; // list speed as throughput [M calls / s] instead of time [ns / call]. The frontier is the same
+    static inline bool ulpError = false; // use the max. ULP error instead of the max. relative error as error
+    static inline std::string fileName; // if set, add the points to this file and analyze all points in it
+};
+
+/// @brief Speed and error of an approximation. Independent of the input and output types, so suites can be compared.
+struct ParetoPoint
+{
+    std::string suiteName; // name of the test suite, e.g. "sqrt"
+    std::string name; // identifier / short name of the method "#1"
+    std::string description; // description of the method "foobar method"
+    double nsPerCall = 0; // execution time per call
+    double nsUncertainty = 0; // standard error of nsPerCall
+    double maxRelativeError = 0; // maximum relative error
+    double maxUlpError = 0; // maximum ULP error
+    bool measurable = true; // false if the time is not clearly above the baseline. Such points are neither optimal nor dominated
+    bool dominated = false; // true if another point is faster and more accurate
+    std::string dominatedBy; // suite and name of the fastest point dominating this one
+};
+
+/// @brief Get the error used for the analysis. NaN is checked using the bits, because -ffast-math assumes it does not exist.
+inline double paretoError(const ParetoPoint& p)
+{
+    const double e = ParetoSettings::ulpError ? p.maxUlpError : p.maxRelativeError;
+    uint64_t bits;
+    std::memcpy(&bits, &e, sizeof(bits));
+    return ((bits >> 52) & 0x7FF) == 0x7FF ? std::numeric_limits<double>::max() : e;
+}
+
+/// @brief Returns true if the time is clearly above the baseline, like for printing the throughput of a result.
+inline bool paretoMeasurable(const ParetoPoint& p)
+{
+    return p.nsPerCall > 2 * p.nsUncertainty;
+}
+
+/// @brief Mark all points that are dominated by another point. Points with a time that is not measurable are skipped.
+inline void markDominated(std::vector<ParetoPoint>& points)
+{
+    for (auto& p : points)
+    {
+        p.measurable = paretoMeasurable(p);
+    }
+    for (auto& p : points)
+    {
+        p.dominated = false;
+        p.dominatedBy.clear();
+        if (!p.measurable)
+        {
+            continue;
+        }
+        const ParetoPoint* fastest = nullptr;
+        for (const auto& o : points)
+        {
+            if (&o == &p || !o.measurable)
+            {
+                continue;
+            }
+            // times within the combined uncertainty are ties, so only the error can decide
+            const double tie = std::sqrt(o.nsUncertainty * o.nsUncertainty + p.nsUncertainty * p.nsUncertainty);
+            const bool atLeastAsGood = o.nsPerCall <= p.nsPerCall + tie && paretoError(o) <= paretoError(p);
+            const bool better = o.nsPerCall < p.nsPerCall - tie || paretoError(o) < paretoError(p);
+            if (atLeastAsGood && better && (fastest == nullptr || o.nsPerCall < fastest->nsPerCall))
+            {
+                fastest = &o;
+            }
+        }
+        if (fastest != nullptr)
+        {
+            p.dominated = true;
+            p.dominatedBy = fastest->suiteName + " " + fastest->name;
+        }
+    }
+}
+
+template <typename ResultT>
+std::vector<ParetoPoint> paretoPoints(const std::vector<ResultT>& rs)
+{
+    std::vector<ParetoPoint> points;
+    for (const auto& r : rs)
+    {
+        ParetoPoint p;
+        p.suiteName = r.suiteName;
+        p.name = r.name;
+        p.description = r.description;
+        p.nsPerCall = r.nsPerCall();
+        p.nsUncertainty = r.nsPerCallUncertainty();
+        p.maxRelativeError = double(r.relativeErrors.maximum);
+        p.maxUlpError = double(r.maxUlpError);
+        points.push_back(p);
+    }
+    return points;
+}
+
+/// @brief Read points from a tab-separated file written by writeParetoPoints(). Returns no points if the file does not exist.
+/// Files without the uncertainty column have an uncertainty of 0.
+inline std::vector<ParetoPoint> readParetoPoints(const std::string& fileName)
+{
+    std::vector<ParetoPoint> points;
+    std::ifstream file(fileName);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        ParetoPoint p;
+        std::string ns;
+        std::string relativeError;
+        std::string ulpError;
+        std::string nsUncertainty;
+        if (std::getline(fields, p.suiteName, '\t') && std::getline(fields, p.name, '\t') && std::getline(fields, p.description, '\t') &&
+            std::getline(fields, ns, '\t') && std::getline(fields, relativeError, '\t') && std::getline(fields, ulpError, '\t'))
+        {
+            p.nsPerCall = std::strtod(ns.c_str(), nullptr);
+            p.maxRelativeError = std::strtod(relativeError.c_str(), nullptr);
+            p.maxUlpError = std::strtod(ulpError.c_str(), nullptr);
+            if (std::getline(fields, nsUncertainty, '\t'))
+            {
+                p.nsUncertainty = std::strtod(nsUncertainty.c_str(), nullptr);
+            }
+            points.push_back(p);
+        }
+    }
+    return points;
+}
+
+inline void writeParetoPoints(const std::string& fileName, const std::vector<ParetoPoint>& points)
+{
+    std::ofstream file(fileName);
+    file.precision(9);
+    for (const auto& p : points)
+    {
+        file << p.suiteName << '\t' << p.name << '\t' << p.description << '\t' << p.nsPerCall << '\t' << p.maxRelativeError << '\t' << p.maxUlpError << '\t' << p.nsUncertainty << std::endl;
+    }
+}
+
+/// @brief Run the Pareto analysis for the results and mark the dominated ones. If ParetoSettings::fileName is set, the points
+/// of the results replace the points of the same suite in the file and all points in the file are analyzed.
+/// @return All points analyzed.
+template <typename ResultT>
+std::vector<ParetoPoint> paretoAnalysis(std::vector<ResultT>& rs)
+{
+    auto points = paretoPoints(rs);
+    if (!ParetoSettings::fileName.empty() && !rs.empty())
+    {
+        auto filePoints = readParetoPoints(ParetoSettings::fileName);
+        const std::string& suiteName = rs.front().suiteName;
+        filePoints.erase(std::remove_if(filePoints.begin(), filePoints.end(), [&suiteName](const ParetoPoint& p)
+                                        { return p.suiteName == suiteName; }),
+                         filePoints.end());
+        filePoints.insert(filePoints.end(), points.cbegin(), points.cend());
+        writeParetoPoints(ParetoSettings::fileName, filePoints);
+        points = filePoints;
+    }
+    markDominated(points);
+    for (auto& r : rs)
+    {
+        auto pIt = std::find_if(points.cbegin(), points.cend(), [&r](const ParetoPoint& p)
+                                { return p.suiteName == r.suiteName && p.name == r.name; });
+        r.paretoMeasurable = pIt->measurable;
+        r.paretoDominated = pIt->dominated;
+        r.paretoDominatedBy = pIt->dominatedBy;
+    }
+    return points;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const std::vector<ParetoPoint>& points)
+{
+    os << "Pareto frontier (" << (ParetoSettings::throughput ? "throughput" : "time") << " vs. max. " << (ParetoSettings::ulpError ? "ULP" : "relative") << " error):" << std::endl;
+    // frontier first, sorted by speed
+    std::vector<const ParetoPoint*> sorted;
+    for (const auto& p : points)
+    {
+        sorted.push_back(&p);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const ParetoPoint* a, const ParetoPoint* b)
+                     { return a->measurable != b->measurable ? a->measurable : (a->dominated != b->dominated ? !a->dominated : a->nsPerCall < b->nsPerCall); });
+    for (const auto* p : sorted)
+    {
+        os << "  " << p->suiteName << " " << p->name << " - " << p->description << ": ";
+        if (!p->measurable)
+        {
+            os << "time not measurable, " << (ParetoSettings::ulpError ? p->maxUlpError : p->maxRelativeError) << std::endl;
+            continue;
+        }
+        if (ParetoSettings::throughput)
+        {
+            os << 1000.0 / p->nsPerCall << " M calls / s, ";
+        }
+        else
+        {
+            os << p->nsPerCall << " ns / call, ";
+        }
+        os << (ParetoSettings::ulpError ? p->maxUlpError : p->maxRelativeError);
+        os << (p->dominated ? ", dominated by " + p->dominatedBy : ", optimal") << std::endl;
+    }
+    return os;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+// Hardware performance counters for measuring e.g. branch mispredictions.
+// Only implemented on Linux using perf_event_open. On other systems or if the
+// kernel does not allow access (see /proc/sys/kernel/perf_event_paranoid),
+// isValid() returns false and all counts are 0.
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class PerfCounter
+{
+  public:
+    enum class Event
+    {
+        BranchMisses
+    };
+
+    explicit PerfCounter(Event event)
+    {
+#if defined(__linux__)
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = eventConfig(event);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)event;
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    ~PerfCounter()
+    {
+#if defined(__linux__)
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+#endif
+    }
+
+    /// @brief Returns true if the counter could be opened and returns meaningful values.
+    bool isValid() const
+    {
+        return m_fd >= 0;
+    }
+
+    /// @brief Reset counter to 0 and start counting.
+    void start()
+    {
+#if defined(__linux__)
+        if (m_fd >= 0)
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /// @brief Stop counting and return the number of events since start().
+    uint64_t stop()
+    {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if (m_fd >= 0)
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_fd, &count, sizeof(count)) != sizeof(count))
+            {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+
+  private:
+#if defined(__linux__)
+    static uint64_t eventConfig(Event event)
+    {
+        switch (event)
+        {
+            case Event::BranchMisses: return PERF_COUNT_HW_BRANCH_MISSES;
+        }
+        return PERF_COUNT_HW_BRANCH_MISSES;
+    }
+#endif
+
+    int m_fd = -1;
+};
@@ -1,8 +1,14 @@
 #pragma once
 
+#include "decimate.h"
+#include "pareto.h"
 #include "result.h"
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <functional>
+#include <limits>
 #include <sciplot/sciplot.hpp>
 #include <string>
 #include <vector>
@@ -37,34 +43,73 @@ typename ResultT::storage_range_t calculateMedianRange(const std::vector<ResultT
     return std::make_pair(*leftIt, *rightIt);
 }
 
+/// @brief Settings for plots, set from the command line.
+struct PlotSettings
+{
+    static inline unsigned width = 1200; // width of the figure in pixels. Curves are reduced to a minimum and maximum value per pixel column
+};
+
+/// @brief Binary data files for gnuplot. Much faster than passing values as text in the plot script.
+/// The files are deleted when the object is destroyed, so it must live until the figure has been saved.
+class PlotDataFiles
+{
+  public:
+    explicit PlotDataFiles(const std::string& baseName)
+        : m_baseName(baseName)
+    {
+    }
+
+    ~PlotDataFiles()
+    {
+        for (const auto& fileName : m_fileNames)
+        {
+            std::remove(fileName.c_str());
+        }
+    }
+
+    PlotDataFiles(const PlotDataFiles&) = delete;
+    PlotDataFiles& operator=(const PlotDataFiles&) = delete;
+
+    /// @brief Write x / y values to a new file and return the gnuplot data source to use in Plot::draw().
+    std::string write(const std::vector<double>& x, const std::vector<double>& y)
+    {
+        const std::string fileName = m_baseName + "." + std::to_string(m_fileNames.size()) + ".bin";
+        std::ofstream file(fileName, std::ios::binary);
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            const double xy[2] = {x[i], y[i]};
+            file.write(reinterpret_cast<const char*>(xy), sizeof(xy));
+        }
+        m_fileNames.push_back(fileName);
+        return "'" + fileName + "' binary format='%float64%float64'";
+    }
+
+  private:
+    std::string m_baseName;
+    std::vector<std::string> m_fileNames;
+};
+
+/// @brief Calculate the range of sizePercent values centered around the median from the precomputed percentiles of all results.
 template <typename ResultT>
-typename ResultT::storage_range_t calculateMedianRange(const std::vector<ResultT>& rs, std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> valuesFunc, typename ResultT::storage_t sizePercent)
+typename ResultT::storage_range_t calculateMedianRange(const std::vector<ResultT>& rs, std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> percentilesFunc, typename ResultT::storage_t sizePercent)
 {
     // calculate min / max percentage range of all values around median
     typename ResultT::storage_range_t rangeMinMax(std::numeric_limits<typename ResultT::storage_t>::max(), std::numeric_limits<typename ResultT::storage_t>::lowest());
+    const auto halfRange = static_cast<std::size_t>(sizePercent / 2);
     for (const auto& r : rs)
     {
-        // calculate median of values
-        std::vector<typename ResultT::storage_t> v = valuesFunc(r);
-        std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
-        auto medianIt = v.cbegin() + v.size() / 2;
-        // now get sizePercent values centered around median
-        const decltype(v.size()) halfRange = v.size() / 2 * sizePercent / 100;
-        auto leftIt = std::prev(medianIt, halfRange);
-        auto rightIt = std::next(medianIt, halfRange);
-        rangeMinMax.first = std::min(rangeMinMax.first, *leftIt);
-        rangeMinMax.second = std::max(rangeMinMax.second, *rightIt);
+        const auto& percentiles = percentilesFunc(r);
+        rangeMinMax.first = std::min(rangeMinMax.first, percentiles[50 - halfRange]);
+        rangeMinMax.second = std::max(rangeMinMax.second, percentiles[50 + halfRange]);
     }
     return rangeMinMax;
 }
 
 template <typename ResultT>
-sciplot::Plot plotLines(const std::vector<ResultT>& rs, std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> valuesFunc, typename ResultT::storage_t sizePercent, const std::string& title, const std::string& yLabel)
+sciplot::Plot plotLines(const std::vector<ResultT>& rs, std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> valuesFunc, std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> percentilesFunc, typename ResultT::storage_t sizePercent, const std::string& title, const std::string& yLabel, PlotDataFiles& dataFiles)
 {
-    auto rangePercent = calculateMedianRange(rs, valuesFunc, sizePercent);
+    auto rangePercent = calculateMedianRange(rs, percentilesFunc, sizePercent);
     rangePercent.second = rangePercent.second - rangePercent.first == 0 ? rangePercent.first + 1 : rangePercent.second;
-    const auto& fr = rs.front();
-    const auto x = sciplot::linspace(fr.inputRange.first, fr.inputRange.second, fr.samplesInRange);
     sciplot::Plot p;
     p.tics();
     p.xlabel("");
@@ -74,7 +119,10 @@ sciplot::Plot plotLines(const std::vector<ResultT>& rs, std::function<const std:
     p.yrange(rangePercent.first, rangePercent.second);
     for (const auto& r : rs)
     {
-        p.drawCurve(x, valuesFunc(r)).label(r.description).lineWidth(1);
+        std::vector<double> x;
+        std::vector<double> y;
+        decimate(r.inputValues, valuesFunc(r), PlotSettings::width, x, y);
+        p.draw(dataFiles.write(x, y), "1:2", "lines").label(r.description).lineWidth(1);
     }
     return p;
 }
@@ -110,10 +158,10 @@ template <typename ResultT, typename std::enable_if<std::is_class<typename Resul
 void plot(const std::vector<ResultT>& rs, const std::string& fileName)
 {
     std::function<typename ResultT::storage_t(const ResultT&)> callNsFunc = [](const ResultT& r)
-    { return float(r.callNs - r.overheadNs) / (float)r.samplesInRange; };
+    { return r.nsPerCall(); };
     auto p0 = plotBars(rs, callNsFunc, (typename ResultT::storage_t)70, "", "Execution time [ns / call]");
     sciplot::Figure mp = {{p0}};
-    mp.size(1200, 800);
+    mp.size(PlotSettings::width, PlotSettings::width * 2 / 3);
     mp.title("Results for " + rs.front().suiteName);
     mp.save(fileName);
 }
@@ -121,20 +169,132 @@ void plot(const std::vector<ResultT>& rs, const std::string& fileName)
 template <typename ResultT, typename std::enable_if<!std::is_class<typename ResultT::input_t>::value, bool>::type = true>
 void plot(const std::vector<ResultT>& rs, const std::string& fileName)
 {
+    PlotDataFiles dataFiles(fileName);
     std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> valueFunc = [](const ResultT& r) -> const std::vector<typename ResultT::storage_t>&
     { return r.values; };
-    auto p0 = plotLines(rs, valueFunc, (typename ResultT::storage_t)98, "Value", "f(x)");
+    std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> valuePercentilesFunc = [](const ResultT& r) -> const std::vector<typename ResultT::storage_t>&
+    { return r.valuePercentiles; };
+    auto p0 = plotLines(rs, valueFunc, valuePercentilesFunc, (typename ResultT::storage_t)98, "Value", "f(x)", dataFiles);
     std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> absFunc = [](const ResultT& r) -> const std::vector<typename ResultT::storage_t>&
     { return r.absoluteErrors.values; };
-    auto p1 = plotLines(rs, absFunc, (typename ResultT::storage_t)80, "Absolute error", "|f(x) - F(x)|");
+    std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> absPercentilesFunc = [](const ResultT& r) -> const std::vector<typename ResultT::storage_t>&
+    { return r.absoluteErrors.percentiles; };
+    auto p1 = plotLines(rs, absFunc, absPercentilesFunc, (typename ResultT::storage_t)80, "Absolute error", "|f(x) - F(x)|", dataFiles);
     std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> relFunc = [](const ResultT& r) -> const std::vector<typename ResultT::storage_t>&
     { return r.relativeErrors.values; };
-    auto p2 = plotLines(rs, relFunc, (typename ResultT::storage_t)80, "Relative error", "|1 - f(x) / F(x)|");
+    std::function<const std::vector<typename ResultT::storage_t>&(const ResultT&)> relPercentilesFunc = [](const ResultT& r) -> const std::vector<typename ResultT::storage_t>&
+    { return r.relativeErrors.percentiles; };
+    auto p2 = plotLines(rs, relFunc, relPercentilesFunc, (typename ResultT::storage_t)80, "Relative error", "|1 - f(x) / F(x)|", dataFiles);
     std::function<typename ResultT::storage_t(const ResultT&)> callNsFunc = [](const ResultT& r)
-    { return float(r.callNs - r.overheadNs) / (float)r.samplesInRange; };
+    { return r.nsPerCall(); };
     auto p3 = plotBars(rs, callNsFunc, (typename ResultT::storage_t)70, "", "Execution time [ns / call]");
     sciplot::Figure mp = {{p0, p3}, {p1, p2}};
-    mp.size(1200, 800);
+    mp.size(PlotSettings::width, PlotSettings::width * 2 / 3);
     mp.title("Results for " + rs.front().suiteName);
     mp.save(fileName);
-}
\ No newline at end of file
+}
+
+/// @brief Plot heatmaps of the maximum relative error and the execution time per input binade for all approximations.
+/// Needs bucket statistics (see TestSettings::bucketStatistics). All results must have the same buckets.
+template <typename ResultT>
+void plotBuckets(const std::vector<ResultT>& rs, const std::string& fileName)
+{
+    const auto& buckets = rs.front().buckets;
+    // image plots need x, y and z values for every cell
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> errors;
+    std::vector<double> times;
+    for (decltype(rs.size()) ri = 0; ri < rs.size(); ri++)
+    {
+        for (decltype(buckets.size()) bi = 0; bi < rs[ri].buckets.size(); bi++)
+        {
+            const auto& b = rs[ri].buckets[bi];
+            x.push_back(bi);
+            y.push_back(ri);
+            // errors can be 0, so limit the logarithm
+            errors.push_back(std::log10(std::max(double(b.maxRelativeError), 1e-20)));
+            times.push_back((double(b.callNs) - double(b.overheadNs)) / double(b.calls));
+        }
+    }
+    // label up to ~16 buckets and all approximations
+    const decltype(buckets.size()) step = std::max(decltype(buckets.size())(1), buckets.size() / 16);
+    std::string xtics = "set xtics noenhanced rotate (";
+    for (decltype(buckets.size()) bi = 0; bi < buckets.size(); bi += step)
+    {
+        xtics += (bi > 0 ? ", \"" : "\"") + buckets[bi].label + "\" " + std::to_string(bi);
+    }
+    xtics += ")";
+    std::string ytics = "set ytics noenhanced (";
+    for (decltype(rs.size()) ri = 0; ri < rs.size(); ri++)
+    {
+        ytics += (ri > 0 ? ", \"" : "\"") + rs[ri].name + "\" " + std::to_string(ri);
+    }
+    ytics += ")";
+    auto heatmap = [&](const std::vector<double>& z, const std::string& title)
+    {
+        sciplot::Plot p;
+        p.gnuplot(xtics);
+        p.gnuplot(ytics);
+        p.gnuplot("set title \"" + title + "\"");
+        p.xlabel("");
+        p.ylabel("");
+        p.legend().hide();
+        p.border().lineWidth(1);
+        p.drawWithVecs("image", x, y, z);
+        return p;
+    };
+    auto p0 = heatmap(errors, "log10(max. relative error)");
+    auto p1 = heatmap(times, "Execution time [ns / call]");
+    sciplot::Figure mp = {{p0}, {p1}};
+    mp.size(PlotSettings::width, PlotSettings::width * 2 / 3);
+    mp.title("Results per binade for " + rs.front().suiteName);
+    mp.save(fileName);
+}
+
+/// @brief Plot the speed and error of all points as a scatter plot. Points on the Pareto frontier are filled and connected.
+/// Points with a time that is not measurable have no speed and are not drawn.
+inline void plotPareto(const std::vector<ParetoPoint>& points, const std::string& fileName)
+{
+    std::vector<double> frontierX;
+    std::vector<double> frontierY;
+    std::vector<double> dominatedX;
+    std::vector<double> dominatedY;
+    std::vector<const ParetoPoint*> sorted;
+    for (const auto& p : points)
+    {
+        if (p.measurable)
+        {
+            sorted.push_back(&p);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const ParetoPoint* a, const ParetoPoint* b)
+              { return a->nsPerCall < b->nsPerCall; });
+    sciplot::Plot p;
+    p.gnuplot("set logscale y");
+    for (const auto* point : sorted)
+    {
+        const double x = ParetoSettings::throughput ? 1000.0 / point->nsPerCall : point->nsPerCall;
+        // errors can be 0, so limit them for the logarithmic axis
+        const double y = std::max(paretoError(*point), 1e-20);
+        (point->dominated ? dominatedX : frontierX).push_back(x);
+        (point->dominated ? dominatedY : frontierY).push_back(y);
+        p.gnuplot("set label noenhanced \"" + point->suiteName + " " + point->name + "\" at " + std::to_string(x) + ", " + std::to_string(y) + " offset 1, 0.5 font \",8\"");
+    }
+    p.xlabel(ParetoSettings::throughput ? "Throughput [M calls / s]" : "Execution time [ns / call]");
+    p.ylabel(ParetoSettings::ulpError ? "Max. ULP error" : "Max. relative error");
+    p.border().lineWidth(1);
+    p.legend().title("Pareto frontier");
+    if (!frontierX.empty())
+    {
+        p.drawCurveWithPoints(frontierX, frontierY).label("optimal").pointType(7).lineWidth(1);
+    }
+    if (!dominatedX.empty())
+    {
+        p.drawPoints(dominatedX, dominatedY).label("dominated").pointType(6);
+    }
+    sciplot::Figure mp = {{p}};
+    mp.size(PlotSettings::width, PlotSettings::width * 2 / 3);
+    mp.title("Speed vs. accuracy");
+    mp.save(fileName);
+}
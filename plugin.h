@@ -0,0 +1,102 @@
+#pragma once
+
+// Load approximations from shared libraries at runtime. See approx_plugin.h for the interface plugins implement.
+// Kernels are run in the test suite they name by Test::runPlugins(), like the built-in approximations.
+// The same source built with different compilers or flags can be loaded from several files and compared in one run.
+
+#include "approx_plugin.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#define APPROX_HAVE_DLOPEN
+#endif
+
+/// @brief ApproxType of a C++ type or 0 if the type can not be used in plugins, e.g. std::tuple or half_t.
+template <typename T>
+constexpr int approxType()
+{
+    if constexpr (std::is_same<T, float>::value)
+    {
+        return APPROX_TYPE_FLOAT;
+    }
+    else if constexpr (std::is_same<T, double>::value)
+    {
+        return APPROX_TYPE_DOUBLE;
+    }
+    else if constexpr (std::is_integral<T>::value && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8))
+    {
+        // APPROX_TYPE_INT16, APPROX_TYPE_UINT16, APPROX_TYPE_INT32, ...
+        const int sizeIndex = sizeof(T) == 2 ? 0 : (sizeof(T) == 4 ? 1 : 2);
+        return APPROX_TYPE_INT16 + 2 * sizeIndex + (std::is_signed<T>::value ? 0 : 1);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/// @brief Kernel loaded from a plugin.
+struct PluginKernel
+{
+    std::string label; // prefix of the result names, e.g. the file name of the plugin "libmysqrt.so"
+    ApproxKernel kernel;
+};
+
+/// @brief Settings for plugins, set from the command line.
+struct PluginSettings
+{
+    static inline std::vector<PluginKernel> kernels; // kernels of all plugins loaded with --plugin
+};
+
+/// @brief Load a plugin and add its kernels to kernels. Plugins are never unloaded, so the kernels stay valid.
+/// Prints an error and returns false if the file can not be loaded or was built for another ABI version.
+/// @param label Prefix of the result names. If empty, the file name of the plugin is used.
+inline bool loadPlugin(const std::string& path, std::vector<PluginKernel>& kernels, const std::string& label = "")
+{
+#if defined(APPROX_HAVE_DLOPEN)
+    // RTLD_LOCAL, so symbols of different builds of the same source do not clash
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr)
+    {
+        std::cout << "Failed to load plugin \"" << path << "\": " << dlerror() << std::endl;
+        return false;
+    }
+    auto entry = reinterpret_cast<ApproxPluginEntry>(dlsym(handle, APPROX_PLUGIN_ENTRY_NAME));
+    const ApproxPlugin* plugin = entry != nullptr ? entry() : nullptr;
+    if (plugin == nullptr)
+    {
+        std::cout << "Plugin \"" << path << "\" does not export " << APPROX_PLUGIN_ENTRY_NAME << "()!" << std::endl;
+        dlclose(handle);
+        return false;
+    }
+    if (plugin->abiVersion != APPROX_PLUGIN_ABI_VERSION)
+    {
+        std::cout << "Plugin \"" << path << "\" has ABI version " << plugin->abiVersion << ", but version " << APPROX_PLUGIN_ABI_VERSION << " is needed!" << std::endl;
+        dlclose(handle);
+        return false;
+    }
+    const auto slash = path.find_last_of('/');
+    const std::string prefix = !label.empty() ? label : (slash != std::string::npos ? path.substr(slash + 1) : path);
+    for (std::size_t i = 0; i < plugin->kernelCount; ++i)
+    {
+        const auto& kernel = plugin->kernels[i];
+        if (kernel.suite == nullptr || kernel.name == nullptr || (kernel.scalar == nullptr && kernel.batch == nullptr))
+        {
+            std::cout << "Plugin \"" << path << "\": Kernel " << i << " needs a suite, a name and a function!" << std::endl;
+            return false;
+        }
+        kernels.push_back({prefix, kernel});
+    }
+    return true;
+#else
+    std::cout << "Loading plugin \"" << path << "\" failed: Plugins are not supported on this platform!" << std::endl;
+    (void)kernels;
+    (void)label;
+    return false;
+#endif
+}
@@ -0,0 +1,52 @@
+/* Example plugin for approx. Build it with the approx_plugin_example target and run
+ * "approx -f sqrtf --plugin ./libapprox_plugin_example.so". Build it with other flags, e.g. -march=x86-64 and
+ * -march=native, and pass both files to compare the builds. See approx_plugin.h. */
+
+#include "approx_plugin.h"
+#include <stdint.h>
+#include <string.h>
+
+/* sqrt(x) = x * 1 / sqrt(x) with the inverse square root from the magic constant + 1x Newton.
+ * See: https://en.wikipedia.org/wiki/Fast_inverse_square_root */
+static float sqrtf_magic(const float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5F375A86 - (bits >> 1);
+    float y;
+    memcpy(&y, &bits, sizeof(y));
+    y = y * (1.5F - 0.5F * x * y * y);
+    return x * y;
+}
+
+/* Batch version the compiler can vectorize */
+static void sqrtf_magic_batch(const void* x, void* y, size_t count)
+{
+    const float* in = (const float*)x;
+    float* out = (float*)y;
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = sqrtf_magic(in[i]);
+    }
+}
+
+/* 1 / x with the magic constant for the reciprocal + 1x Newton, like recipf_2 */
+static float recipf_magic(const float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x7EF311C3 - bits;
+    float y;
+    memcpy(&y, &bits, sizeof(y));
+    return y * (2.0F - x * y);
+}
+
+static const ApproxKernel kernels[] = {
+    {"sqrtf", "#magic", "Magic constant + 1x Newton", APPROX_TYPE_FLOAT, APPROX_TYPE_FLOAT, (ApproxFunction)&sqrtf_magic, &sqrtf_magic_batch, 1.17549435e-38, 3.40282347e+38},
+    {"recipf", "#magic", "Magic constant + 1x Newton", APPROX_TYPE_FLOAT, APPROX_TYPE_FLOAT, (ApproxFunction)&recipf_magic, NULL, 0, 0}};
+
+APPROX_PLUGIN_EXPORT const ApproxPlugin* approx_plugin(void)
+{
+    static const ApproxPlugin plugin = {APPROX_PLUGIN_ABI_VERSION, sizeof(kernels) / sizeof(kernels[0]), kernels};
+    return &plugin;
+}
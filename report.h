@@ -0,0 +1,448 @@
+#pragma once
+
+// Self-contained HTML report that does not need gnuplot: the results are embedded as JavaScript data and the charts
+// are drawn as SVG in the browser. Curves are decimated (see decimate.h) and the data is written directly to the file,
+// so the size of the report and the time to write it do not grow with the number of samples.
+// The table can be sorted by clicking a column header. Approximations that are both slower and less accurate
+// than another one are dominated and shown in grey. The result of the Pareto analysis is used if it was run (see pareto.h),
+// otherwise dominated approximations are found in the browser using the max. relative error.
+// With --mca the predicted cycles, latency and bottleneck per CPU model are listed next to the measured time (see mca.h).
+
+#include "decimate.h"
+#include "html.h"
+#include "mca.h"
+#include "pareto.h"
+#include "result.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// number of points per curve in the report
+#define REPORT_CURVE_COLUMNS 600
+
+static const std::string ReportStyle =
+    R"(<style>
+    body { font-family: sans-serif; }
+    .charts { display: flex; flex-wrap: wrap; justify-content: center; }
+    .chart { margin: 8px; }
+    .chart text { font-size: 11px; }
+    #results th { cursor: pointer; }
+    #results tr.dominated td { color: #aaa; }
+    .heatmap td { min-width: 14px; height: 14px; font-size: 70%; }
+</style>
+)";
+
+static const std::string ReportScript =
+    R"JS(<script>
+const colors = ["#1f77b4", "#ff7f0e", "#2ca02c", "#d62728", "#9467bd", "#8c564b", "#e377c2", "#7f7f7f", "#bcbd22", "#17becf"];
+const svgNS = "http://www.w3.org/2000/svg";
+const finite = v => Number.isFinite(v);
+
+function tooltip(element, text) {
+    svgElement(element, "title", {}, text);
+}
+
+function svgElement(parent, name, attributes, text) {
+    const e = document.createElementNS(svgNS, name);
+    for (const key in attributes) e.setAttribute(key, attributes[key]);
+    if (text !== undefined) e.textContent = text;
+    parent.appendChild(e);
+    return e;
+}
+
+// Create an SVG chart with axes. Returns functions mapping values to pixels
+function createChart(title, xRange, yRange, logY) {
+    const width = 560, height = 340, left = 70, right = 10, top = 24, bottom = 40;
+    const svg = svgElement(document.getElementById("charts"), "svg", { width: width, height: height, class: "chart" });
+    svgElement(svg, "text", { x: width / 2, y: 14, "text-anchor": "middle", "font-weight": "bold" }, title);
+    const ty = v => logY ? Math.log10(Math.max(v, 1e-30)) : v;
+    const y0 = ty(yRange[0]), y1 = ty(yRange[1]) > y0 ? ty(yRange[1]) : y0 + 1;
+    const x0 = xRange[0], x1 = xRange[1] > x0 ? xRange[1] : x0 + 1;
+    const px = x => left + (x - x0) / (x1 - x0) * (width - left - right);
+    const py = y => height - bottom - (Math.min(Math.max(ty(y), y0 - (y1 - y0)), y1 + (y1 - y0)) - y0) / (y1 - y0) * (height - top - bottom);
+    const clipId = "clip" + document.querySelectorAll("svg").length;
+    svgElement(svgElement(svg, "clipPath", { id: clipId }), "rect", { x: left, y: top, width: width - left - right, height: height - top - bottom });
+    svgElement(svg, "rect", { x: left, y: top, width: width - left - right, height: height - top - bottom, fill: "none", stroke: "#888" });
+    for (let i = 0; i <= 4; ++i) {
+        const xv = x0 + (x1 - x0) * i / 4;
+        svgElement(svg, "text", { x: px(xv), y: height - bottom + 14, "text-anchor": "middle" }, xv.toPrecision(3));
+        const yv = y0 + (y1 - y0) * i / 4;
+        const yp = height - bottom - i / 4 * (height - top - bottom);
+        svgElement(svg, "text", { x: left - 4, y: yp + 4, "text-anchor": "end" }, logY ? "1e" + yv.toFixed(1) : yv.toPrecision(3));
+    }
+    const plot = svgElement(svg, "g", { "clip-path": "url(#" + clipId + ")" });
+    return { svg: svg, plot: plot, px: px, py: py };
+}
+
+function lineChart(title, key, rangeKey) {
+    if (!data.curves) return;
+    const yRange = [Math.min(...data.results.map(r => r[rangeKey][0]).filter(finite)), Math.max(...data.results.map(r => r[rangeKey][1]).filter(finite))];
+    const chart = createChart(title, data.inputRange, yRange, false);
+    data.results.forEach((r, i) => {
+        const curve = r[key];
+        const points = curve.x.map((x, j) => finite(curve.y[j]) ? chart.px(x).toFixed(1) + "," + chart.py(curve.y[j]).toFixed(1) : "").filter(p => p).join(" ");
+        tooltip(svgElement(chart.plot, "polyline", { points: points, fill: "none", stroke: colors[i % colors.length], "stroke-width": 1 }), r.description);
+        svgElement(chart.svg, "text", { x: 560 - 14, y: 40 + 13 * i, "text-anchor": "end", fill: colors[i % colors.length] }, r.description);
+    });
+}
+
+function barChart() {
+    const chart = createChart("Execution time [ns / call]", [0, data.results.length], [0, Math.max(...data.results.map(r => r.ns).filter(finite), 0)], false);
+    data.results.forEach((r, i) => {
+        const y = chart.py(Math.max(r.ns, 0));
+        tooltip(svgElement(chart.plot, "rect", { x: chart.px(i + 0.15), y: y, width: chart.px(i + 0.85) - chart.px(i + 0.15), height: chart.py(0) - y, fill: colors[i % colors.length] }),
+            r.description + ": " + r.ns.toPrecision(3) + " ns");
+    });
+}
+
+// error and speed used for the Pareto analysis. Selected with -P, otherwise max. relative error and ns / call.
+// times that are not clearly above the baseline can not be compared and have no speed, like in pareto.h
+const paretoError = r => data.paretoUlp ? r.ulpMax : r.relMax;
+const paretoMeasurable = r => finite(r.ns) && r.ns > 2 * r.nsError;
+const paretoSpeed = r => !paretoMeasurable(r) ? NaN : (data.paretoThroughput ? 1000 / r.ns : r.ns);
+
+// mark results where another result is at least as fast and as accurate and better in one of them.
+// times within the combined uncertainty are ties. only used if the analysis was not done by approx (-P)
+function markDominated() {
+    const error = r => finite(paretoError(r)) ? paretoError(r) : Infinity;
+    data.results.forEach(r => {
+        r.dominated = paretoMeasurable(r) && data.results.some(o => {
+            const tie = Math.hypot(o.nsError, r.nsError);
+            return o !== r && paretoMeasurable(o) && o.ns <= r.ns + tie && error(o) <= error(r) && (o.ns < r.ns - tie || error(o) < error(r));
+        });
+    });
+}
+
+function paretoChart() {
+    const errors = data.results.map(paretoError).filter(v => finite(v) && v > 0);
+    const title = "Pareto: max. " + (data.paretoUlp ? "ULP" : "relative") + " error vs. " + (data.paretoThroughput ? "throughput [M calls / s]" : "execution time [ns / call]");
+    const chart = createChart(title, [0, Math.max(...data.results.map(paretoSpeed).filter(finite), 0) * 1.1],
+        [Math.min(...errors, 1e-9), Math.max(...errors, 1e-9) * 10], true);
+    const frontier = data.results.filter(r => !r.dominated && paretoMeasurable(r) && finite(paretoError(r))).sort((a, b) => a.ns - b.ns);
+    svgElement(chart.plot, "polyline", { points: frontier.map(r => chart.px(paretoSpeed(r)) + "," + chart.py(paretoError(r))).join(" "), fill: "none", stroke: "#d62728", "stroke-dasharray": "4 2" });
+    data.results.forEach((r, i) => {
+        if (!paretoMeasurable(r)) return;
+        const c = svgElement(chart.plot, "circle", { cx: chart.px(paretoSpeed(r)), cy: chart.py(paretoError(r)), r: 5, stroke: colors[i % colors.length], "stroke-width": 2, fill: r.dominated ? "none" : colors[i % colors.length] });
+        tooltip(c, r.name + " " + r.description);
+        svgElement(chart.plot, "text", { x: chart.px(paretoSpeed(r)) + 7, y: chart.py(paretoError(r)) - 4 }, r.name);
+    });
+}
+
+const columns = [
+    ["Method", r => r.name + " " + r.description], ["Abs. max.", r => r.absMax], ["Abs. mean", r => r.absMean], ["Abs. median", r => r.absMedian],
+    ["Rel. max.", r => r.relMax], ["Rel. mean", r => r.relMean], ["Rel. median", r => r.relMedian], ["ULP max.", r => r.ulpMax], ["stddev", r => r.stddev],
+    ["ns / call", r => r.ns], ["Branch misses / call", r => r.branchMisses], ["Valid range", r => r.valid ? r.valid.join(" .. ") : null],
+    ["Pareto", r => !paretoMeasurable(r) ? "time not measurable" : (r.dominated ? "dominated" + (r.dominatedBy ? " by " + r.dominatedBy : "") : "optimal")]];
+// static analysis (see mca.h): instructions of the loop body and cycles / iteration, latency and bottleneck per CPU model
+if (data.mcaCpus.length > 0) {
+    columns.push(["Instructions", r => r.mca ? r.mca.instructions + (r.mca.loop ? " (loop)" : "") : null]);
+    data.mcaCpus.forEach((cpu, i) => {
+        const cost = r => r.mca && r.mca.costs[i] && !r.mca.costs[i].error ? r.mca.costs[i] : null;
+        columns.push([cpu + " cycles", r => cost(r) ? cost(r).cycles : null], [cpu + " latency", r => cost(r) ? cost(r).latency : null],
+            [cpu + " bottleneck", r => cost(r) ? cost(r).bottleneck + " " + cost(r).pressure.toFixed(2) : (r.mca && r.mca.costs[i] ? r.mca.costs[i].error : null)]);
+    });
+}
+let sortColumn = -1, sortAscending = true;
+
+function format(v) {
+    return typeof v === "number" ? v.toPrecision(3) : (v === null ? "" : v);
+}
+
+function table() {
+    const t = document.getElementById("results");
+    t.innerHTML = "";
+    const header = t.insertRow();
+    columns.forEach((c, i) => {
+        const th = document.createElement("th");
+        th.textContent = c[0] + (i === sortColumn ? (sortAscending ? " ▲" : " ▼") : "");
+        th.onclick = () => { sortAscending = i === sortColumn ? !sortAscending : true; sortColumn = i; table(); };
+        header.appendChild(th);
+    });
+    const rows = data.results.slice();
+    if (sortColumn >= 0) {
+        const value = columns[sortColumn][1];
+        rows.sort((a, b) => {
+            const va = value(a), vb = value(b);
+            const order = typeof va === "number" && typeof vb === "number" ? (finite(va) ? va : Infinity) - (finite(vb) ? vb : Infinity) : String(va).localeCompare(String(vb));
+            return sortAscending ? order : -order;
+        });
+    }
+    rows.forEach(r => {
+        const row = t.insertRow();
+        if (r.dominated) row.className = "dominated";
+        columns.forEach(c => { row.insertCell().textContent = format(c[1](r)); });
+    });
+}
+
+function heatmap() {
+    if (data.buckets.length === 0) return;
+    const t = document.getElementById("buckets");
+    const header = t.insertRow();
+    header.insertCell().textContent = "Max. relative error per binade";
+    data.buckets.forEach(label => { const th = document.createElement("th"); th.textContent = ""; th.title = label; header.appendChild(th); });
+    data.results.forEach(r => {
+        const row = t.insertRow();
+        row.insertCell().textContent = r.name + " " + r.description;
+        r.buckets.forEach((b, i) => {
+            const cell = row.insertCell();
+            // map log10(error) from [-10, 0] to green ... red
+            const e = finite(b[0]) ? Math.log10(Math.max(b[0], 1e-10)) : 0;
+            cell.style.background = "hsl(" + Math.round(Math.min(Math.max(-e / 10, 0), 1) * 120) + ", 70%, 55%)";
+            cell.title = data.buckets[i] + ": " + format(b[0]) + ", " + format(b[1]) + " ns / call";
+        });
+    });
+}
+
+if (!data.pareto) markDominated();
+lineChart("Value f(x)", "value", "valueRange");
+barChart();
+lineChart("Absolute error |f(x) - F(x)|", "abs", "absRange");
+lineChart("Relative error |1 - f(x) / F(x)|", "rel", "relRange");
+paretoChart();
+table();
+heatmap();
+</script>
+)JS";
+
+/// @brief Write a number as JavaScript literal. NaN and inf are checked using the bits, because -ffast-math assumes they do not exist.
+inline void jsNumber(std::ostream& os, const double v)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    if (((bits >> 52) & 0x7FF) == 0x7FF)
+    {
+        os << ((bits & 0xFFFFFFFFFFFFFULL) != 0 ? "NaN" : ((bits >> 63) != 0 ? "-Infinity" : "Infinity"));
+    }
+    else
+    {
+        os << v;
+    }
+}
+
+/// @brief Write a string as JavaScript string literal.
+inline void jsString(std::ostream& os, const std::string& s)
+{
+    os << '"';
+    for (const char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            os << '\\' << c;
+        }
+        else if (c == '<')
+        {
+            // so "</script>" can not end the script
+            os << "\\x3C";
+        }
+        else if (c == '\n')
+        {
+            os << "\\n";
+        }
+        else
+        {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+inline void jsArray(std::ostream& os, const std::vector<double>& values)
+{
+    os << '[';
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        os << (i > 0 ? "," : "");
+        jsNumber(os, values[i]);
+    }
+    os << ']';
+}
+
+/// @brief Write a decimated curve as {x: [...], y: [...]}.
+template <typename ResultT>
+void jsCurve(std::ostream& os, const ResultT& r, const std::vector<typename ResultT::storage_t>& values)
+{
+    std::vector<double> x;
+    std::vector<double> y;
+    decimate(r.inputValues, values, REPORT_CURVE_COLUMNS, x, y);
+    os << "{x:";
+    jsArray(os, x);
+    os << ",y:";
+    jsArray(os, y);
+    os << '}';
+}
+
+/// @brief Write the range of sizePercent values centered around the median, like the plots use.
+template <typename StorageT>
+void jsPercentileRange(std::ostream& os, const std::vector<StorageT>& percentiles, std::size_t sizePercent)
+{
+    jsArray(os, {double(percentiles[50 - sizePercent / 2]), double(percentiles[50 + sizePercent / 2])});
+}
+
+template <typename ResultT>
+void reportData(std::ostream& os, const std::vector<ResultT>& rs)
+{
+    // curves need an input value on the x axis
+    constexpr bool HasCurves = !std::is_class<typename ResultT::input_t>::value;
+    const auto& fr = rs.front();
+    os.precision(7);
+    os << "<script>" << std::endl;
+    os << "const data = {suite:";
+    jsString(os, fr.suiteName);
+    os << ",curves:" << (HasCurves ? "true" : "false") << ",inputRange:";
+    if constexpr (HasCurves)
+    {
+        // the input values, not the range, because generators like "special" or "file" can return values outside of it
+        std::pair<double, double> xRange(double(fr.inputRange.first), double(fr.inputRange.second));
+        drawableRange(fr.inputValues, xRange);
+        jsArray(os, {xRange.first, xRange.second});
+    }
+    else
+    {
+        os << "[0,1]";
+    }
+    os << ",pareto:" << (ParetoSettings::enabled ? "true" : "false");
+    os << ",paretoThroughput:" << (ParetoSettings::throughput ? "true" : "false");
+    os << ",paretoUlp:" << (ParetoSettings::ulpError ? "true" : "false");
+    os << ",mcaCpus:[";
+    for (const auto& cpu : McaSettings::cpus)
+    {
+        os << (&cpu != &McaSettings::cpus.front() ? "," : "");
+        jsString(os, cpu);
+    }
+    os << "]";
+    os << ",buckets:[";
+    for (const auto& b : fr.buckets)
+    {
+        os << (&b != &fr.buckets.front() ? "," : "");
+        jsString(os, b.label);
+    }
+    os << "],results:[" << std::endl;
+    for (const auto& r : rs)
+    {
+        os << "{name:";
+        jsString(os, r.name);
+        os << ",description:";
+        jsString(os, r.description);
+        os << ",ns:";
+        jsNumber(os, r.nsPerCall());
+        os << ",nsError:";
+        jsNumber(os, r.nsPerCallUncertainty());
+        os << ",absMax:";
+        jsNumber(os, double(r.absoluteErrors.maximum));
+        os << ",absMean:";
+        jsNumber(os, double(r.absoluteErrors.mean));
+        os << ",absMedian:";
+        jsNumber(os, double(r.absoluteErrors.median));
+        os << ",relMax:";
+        jsNumber(os, double(r.relativeErrors.maximum));
+        os << ",relMean:";
+        jsNumber(os, double(r.relativeErrors.mean));
+        os << ",relMedian:";
+        jsNumber(os, double(r.relativeErrors.median));
+        os << ",stddev:";
+        jsNumber(os, double(r.stddev));
+        os << ",ulpMax:";
+        jsNumber(os, double(r.maxUlpError));
+        os << ",dominated:" << (r.paretoDominated ? "true" : "false") << ",dominatedBy:";
+        jsString(os, r.paretoDominatedBy);
+        os << ",branchMisses:";
+        if (r.hasBranchMisses)
+        {
+            jsNumber(os, double(r.branchMisses) / double(r.samplesInRange));
+        }
+        else
+        {
+            os << "null";
+        }
+        os << ",valid:";
+        if constexpr (std::is_arithmetic<typename ResultT::input_t>::value)
+        {
+            if (r.hasValidRange)
+            {
+                jsArray(os, {double(r.validRange.first), double(r.validRange.second)});
+            }
+            else
+            {
+                os << "null";
+            }
+        }
+        else
+        {
+            os << "null";
+        }
+        os << ",mca:";
+        if (!r.staticAnalysis.function.empty())
+        {
+            os << "{instructions:" << r.staticAnalysis.instructions << ",loop:" << (r.staticAnalysis.isLoop ? "true" : "false") << ",costs:[";
+            for (const auto& cost : r.staticAnalysis.costs)
+            {
+                os << (&cost != &r.staticAnalysis.costs.front() ? "," : "") << "{cycles:";
+                jsNumber(os, cost.cyclesPerIteration);
+                os << ",latency:";
+                jsNumber(os, cost.latencyCycles);
+                os << ",bottleneck:";
+                jsString(os, cost.bottleneck);
+                os << ",pressure:";
+                jsNumber(os, cost.bottleneckPressure);
+                os << ",error:";
+                jsString(os, cost.error);
+                os << '}';
+            }
+            os << "]}";
+        }
+        else
+        {
+            os << "null";
+        }
+        if constexpr (HasCurves)
+        {
+            os << ",valueRange:";
+            jsPercentileRange(os, r.valuePercentiles, 98);
+            os << ",absRange:";
+            jsPercentileRange(os, r.absoluteErrors.percentiles, 80);
+            os << ",relRange:";
+            jsPercentileRange(os, r.relativeErrors.percentiles, 80);
+            os << "," << std::endl
+               << "value:";
+            jsCurve(os, r, r.values);
+            os << "," << std::endl
+               << "abs:";
+            jsCurve(os, r, r.absoluteErrors.values);
+            os << "," << std::endl
+               << "rel:";
+            jsCurve(os, r, r.relativeErrors.values);
+        }
+        os << ",buckets:[";
+        for (const auto& b : r.buckets)
+        {
+            os << (&b != &r.buckets.front() ? "," : "") << '[';
+            jsNumber(os, double(b.maxRelativeError));
+            os << ',';
+            jsNumber(os, (double(b.callNs) - double(b.overheadNs)) / double(b.calls));
+            os << ']';
+        }
+        os << "]}," << std::endl;
+    }
+    os << "]};" << std::endl;
+    os << "</script>" << std::endl;
+}
+
+/// @brief Write a self-contained HTML report with charts, a sortable table and the Pareto frontier. Does not need gnuplot.
+template <typename ResultT>
+void report(const std::vector<ResultT>& rs, const std::string& fileName)
+{
+    std::ofstream reportFile(fileName);
+    reportFile << HTML5BoilerPlateStart << std::endl;
+    reportFile << ReportStyle;
+    reportFile << "<h2 class=\"center\">Results for " << rs.front().suiteName << "</h2>" << std::endl;
+    reportFile << "<div id=\"charts\" class=\"charts\"></div>" << std::endl;
+    reportFile << "<table id=\"results\" class=\"centercontainer\"></table>" << std::endl;
+    reportFile << "<table id=\"buckets\" class=\"centercontainer heatmap\"></table>" << std::endl;
+    reportData(reportFile, rs);
+    reportFile << ReportScript;
+    reportFile << HTML5BoilerPlateEnd;
+}
@@ -1,10 +1,34 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <string>
 #include <vector>
 
+/// @brief Costs of the machine code of an approximation predicted by llvm-mca for a CPU model. See mca.h.
+struct StaticCost
+{
+    std::string cpu; // CPU model, e.g. "skylake"
+    double cyclesPerIteration = 0; // cycles per iteration of the loop body when iterations are independent (reciprocal throughput)
+    double latencyCycles = 0; // cycles a single iteration takes from start to end
+    double ipc = 0; // instructions per cycle
+    std::string bottleneck; // execution resource with the highest pressure, e.g. "SKLPort0"
+    double bottleneckPressure = 0; // cycles per iteration the bottleneck is busy
+    std::string error; // set if llvm-mca failed, e.g. because the CPU model does not support an instruction
+};
+
+/// @brief Disassembled machine code of an approximation and its predicted costs. See mca.h.
+struct StaticAnalysis
+{
+    std::string function; // function the machine code is from, e.g. "sqrtf_9(float)". Empty if not analyzed
+    std::string asmFileName; // file the disassembled loop body was written to
+    std::size_t instructions = 0; // number of instructions in the loop body
+    bool isLoop = false; // true if the loop body is a loop in the function, e.g. of a batch function. False for the whole function
+    bool hasCalls = false; // true if the loop body calls other functions, which llvm-mca does not model
+    std::vector<StaticCost> costs; // costs per CPU model. Empty if llvm-mca was not run
+};
+
 template <typename InputT, typename StorageT>
 struct Result
 {
@@ -21,6 +45,44 @@ struct Result
         storage_t mean; // average of error values
         storage_t median; // median of error values
         storage_t variance; // variance of error values
+        std::vector<storage_t> percentiles; // error values at 0%, 1%, ..., 100% of the sorted values
+    };
+
+    struct OrderTiming
+    {
+        std::string order; // order of the input values, e.g. "shuffled"
+        uint64_t callNs = 0; // execution time for all calls of the function (accumulated)
+        uint64_t overheadNs = 0; // execution time of the baseline for all calls, measured interleaved with callNs (accumulated)
+        uint64_t branchMisses = 0; // branch mispredictions for all calls of the function (accumulated)
+    };
+
+    struct ModeResult
+    {
+        std::string mode; // floating-point mode, e.g. "FTZ+DAZ"
+        uint64_t callNs = 0; // execution time for all calls of the function (accumulated)
+        uint64_t overheadNs = 0; // execution time of the baseline for all calls with this mode (accumulated)
+        storage_t maxAbsoluteError = 0; // maximum absolute error with this mode
+        storage_t maxRelativeError = 0; // maximum relative error with this mode
+    };
+
+    struct Bucket
+    {
+        std::string label; // input values of the bucket, e.g. "[2^3, 2^4)"
+        std::size_t samples = 0; // number of input values in the bucket
+        storage_t maxAbsoluteError = 0; // maximum absolute error in the bucket
+        storage_t meanAbsoluteError = 0; // average absolute error in the bucket
+        storage_t maxRelativeError = 0; // maximum relative error in the bucket
+        storage_t meanRelativeError = 0; // average relative error in the bucket
+        std::size_t calls = 0; // number of calls callNs was measured for. Values of small buckets are repeated for a precise time
+        uint64_t callNs = 0; // execution time for all calls of the function with the values of the bucket (accumulated)
+        uint64_t overheadNs = 0; // execution time of the baseline for the calls (accumulated)
+    };
+
+    struct FuzzFailure
+    {
+        input_t input; // minimized failing input
+        storage_t value; // result of the approximation. The worst value for functions returning multiple values
+        storage_t reference; // result of the reference function
     };
 
     std::string suiteName; // name of the test suite, e.g. "sqrtf"
@@ -28,10 +90,47 @@ struct Result
     std::string description; // description of the method "foobar method"
     input_range_t inputRange; // range of input values
     std::size_t samplesInRange = 0; // number of points in range (2,n)
-    std::vector<storage_t> values; // approx_f(x) of all calls
+    std::vector<input_t> inputValues; // x of all calls, in the same order as values and the errors
+    std::vector<storage_t> values; // approx_f(x) of all calls. First value only for functions returning multiple values
+    std::vector<storage_t> valuePercentiles; // values at 0%, 1%, ..., 100% of the sorted values
     Errors absoluteErrors; // absolute error abs(approx_f(x) - f(x)) of all calls
     Errors relativeErrors; // relative error abs(1 - approx_f(x) / f(x)) of all calls
     storage_t stddev = std::numeric_limits<storage_t>::max(); // standard deviation sqrt(sum(sqr(approx_f(x) - f(x))) / (N - 1))
+    storage_t maxUlpError = 0; // maximum error in units in the last place of f(x) in the output type (LSBs for integers)
     uint64_t callNs = 0; // execution time for all calls of the function (accumulated)
-    uint64_t overheadNs = 0; // estimated loop and data fetch overhead (accumulated)
+    uint64_t overheadNs = 0; // execution time of a baseline with the same loop, loads, stores and type conversions, but no calculation (accumulated)
+    double uncertaintyNs = 0; // standard error of callNs - overheadNs
+    bool hasBranchMisses = false; // true if branch mispredictions could be measured
+    uint64_t branchMisses = 0; // branch mispredictions for all calls of the function (accumulated)
+    std::vector<OrderTiming> orderTimings; // execution times with the input values in sorted, shuffled and alternating order. Empty if not measured
+    std::vector<ModeResult> modeResults; // execution times and errors with different floating-point modes. Empty if not measured
+    std::vector<Bucket> buckets; // errors and execution times per binade of the input values. Empty if not measured
+    double validityThreshold = 0; // maximum relative error used to find validRange. 0 if not searched
+    bool hasValidRange = false; // true if a valid range was found
+    input_range_t validRange{}; // longest interval of input values where the relative error is <= validityThreshold
+    bool paretoMeasurable = true; // false if the time is too close to the baseline for the Pareto analysis. See pareto.h
+    bool paretoDominated = false; // true if another approximation is faster and more accurate. See pareto.h
+    std::string paretoDominatedBy; // suite and name of the fastest approximation dominating this one
+    uint64_t fuzzInputs = 0; // number of inputs checked by the fuzzer. 0 if not fuzzed. See fuzz.h
+    uint64_t fuzzFailures = 0; // number of inputs with a non-finite result or errors larger than the tolerances
+    bool fuzzHasBaseline = false; // true if the errors were checked against the tolerances of a baseline
+    storage_t fuzzRelativeTolerance = 0; // relative error allowed by the baseline
+    storage_t fuzzAbsoluteTolerance = 0; // absolute error allowed by the baseline
+    storage_t fuzzMaxUlpError = 0; // error in ULPs of the output type allowed by the fuzzer. 0 if not checked
+    std::vector<FuzzFailure> fuzzFailingInputs; // minimized failing inputs
+    const void* kernelAddress = nullptr; // address of the approximation function, used to find its machine code. nullptr for lambdas
+    StaticAnalysis staticAnalysis; // instruction-level costs of the machine code. See mca.h
+
+    /// @brief Execution time per call with the overhead subtracted. Can be <= 0 if the function is as fast as the baseline,
+    /// but not by more than nsPerCallUncertainty().
+    double nsPerCall() const
+    {
+        return (double(callNs) - double(overheadNs)) / double(samplesInRange);
+    }
+
+    /// @brief Standard error of nsPerCall().
+    double nsPerCallUncertainty() const
+    {
+        return uncertaintyNs / double(samplesInRange);
+    }
 };
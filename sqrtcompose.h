@@ -0,0 +1,193 @@
+#pragma once
+
+// Square root approximations composed at compile time from an initial guess (seed), a refinement method
+// and the number of refinement steps, e.g. Sqrt<QuakeSeed<0x5F375A86>, Halley, 2>.
+// Seeds estimate either sqrt(x) or 1 / sqrt(x) (Inverse == true). An inverse estimate is multiplied by x at the end.
+// Refinements have a step for sqrt(x) and, if SupportsInverse is true, a step for 1 / sqrt(x).
+// Everything is a static inline function, so the compiler can inline and unroll the whole approximation.
+// Note that most refinements calculate y^2 or x / 2, which are denormal for x close to FLT_MIN and flushed to zero with -ffast-math.
+// See: https://en.wikipedia.org/wiki/Methods_of_computing_square_roots
+// See: https://en.wikipedia.org/wiki/Fast_inverse_square_root
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+/// @brief Guess log2(x) / 2 using the bit pattern and subtract Bias to balance the error (see sqrtf_1 - sqrtf_4).
+template <uint32_t Bias>
+struct Log2Seed
+{
+    static constexpr bool Inverse = false;
+
+    static std::string name()
+    {
+        return Bias == 0 ? "log2(x)" : "log2(x) + bias";
+    }
+
+    static inline float guess(const float x)
+    {
+        uint32_t i;
+        std::memcpy(&i, &x, sizeof(i));
+        i = (1U << 29) + (i >> 1) - (1U << 22) - Bias;
+        float y;
+        std::memcpy(&y, &i, sizeof(y));
+        return y;
+    }
+};
+
+/// @brief Bit twiddling from Intel Software Optimization Cookbook (see sqrtf_7).
+struct IntelSeed
+{
+    static constexpr bool Inverse = false;
+
+    static std::string name()
+    {
+        return "Intel SOC";
+    }
+
+    static inline float guess(const float x)
+    {
+        uint32_t i;
+        std::memcpy(&i, &x, sizeof(i));
+        i = (i + (127U << 23)) >> 1;
+        float y;
+        std::memcpy(&y, &i, sizeof(y));
+        return y;
+    }
+};
+
+/// @brief "Quake 3 fast inverse square root" guess for 1 / sqrt(x) using a magic constant (see invsqrtf_1 / sqrtf_5).
+template <uint32_t Magic>
+struct QuakeSeed
+{
+    static constexpr bool Inverse = true;
+
+    static std::string name()
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "Quake3 0x%08X", Magic);
+        return buffer;
+    }
+
+    static inline float guess(const float x)
+    {
+        uint32_t i;
+        std::memcpy(&i, &x, sizeof(i));
+        i = Magic - (i >> 1);
+        float y;
+        std::memcpy(&y, &i, sizeof(y));
+        return y;
+    }
+};
+
+/// @brief Newton's method, doubles the number of correct bits per step.
+/// For sqrt(x) this is the Babylonian method y = (y + x / y) / 2, for 1 / sqrt(x) y = y * (1.5 - 0.5 * x * y^2) without division.
+struct Newton
+{
+    static constexpr bool SupportsInverse = true;
+
+    static std::string name()
+    {
+        return "Newton";
+    }
+
+    static inline float step(const float x, const float y)
+    {
+        return 0.5F * (y + x / y);
+    }
+
+    static inline float inverseStep(const float x, const float y)
+    {
+        return y * (1.5F - 0.5F * x * y * y);
+    }
+};
+
+/// @brief Halley's method, triples the number of correct bits per step.
+/// For sqrt(x) y = y * (y^2 + 3 * x) / (3 * y^2 + x). For 1 / sqrt(x) the division is replaced by its
+/// Taylor series y = y * (15 - 10 * r + 3 * r^2) / 8 with r = x * y^2, like sqrtf_6 does.
+struct Halley
+{
+    static constexpr bool SupportsInverse = true;
+
+    static std::string name()
+    {
+        return "Halley";
+    }
+
+    static inline float step(const float x, const float y)
+    {
+        const float y2 = y * y;
+        return y * ((y2 + 3.0F * x) / (3.0F * y2 + x));
+    }
+
+    static inline float inverseStep(const float x, const float y)
+    {
+        const float r = x * y * y;
+        return y * (0.125F * (15.0F + r * (3.0F * r - 10.0F)));
+    }
+};
+
+/// @brief Bakhshali method, quadruples the number of correct bits per step. Only exists for sqrt(x).
+/// Note that sqrtf_4 / sqrtf_8 only use the first half (y^2 + x) / (2 * y), which is a Newton step.
+/// See: https://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Bakhshali_method
+struct Bakhshali
+{
+    static constexpr bool SupportsInverse = false;
+
+    static std::string name()
+    {
+        return "Bakhshali";
+    }
+
+    static inline float step(const float x, const float y)
+    {
+        const float a = (x - y * y) / (2.0F * y);
+        const float b = y + a;
+        return b - (a * a) / (2.0F * b);
+    }
+};
+
+/// @brief Check if a refinement can be used with a seed.
+template <typename Seed, typename Refinement>
+constexpr bool isValidSqrt()
+{
+    return !Seed::Inverse || Refinement::SupportsInverse;
+}
+
+/// @brief sqrt(x) using an initial guess from Seed and Steps iterations of Refinement.
+template <typename Seed, typename Refinement, int Steps>
+struct Sqrt
+{
+    static_assert(Steps >= 0, "Number of steps must be >= 0");
+    static_assert(isValidSqrt<Seed, Refinement>(), "Refinement has no step for 1 / sqrt(x) seeds");
+
+    static std::string name()
+    {
+        return Steps == 0 ? Seed::name() : Seed::name() + " + " + (Steps > 1 ? std::to_string(Steps) + "x " : "") + Refinement::name();
+    }
+
+    static inline float compute(const float x)
+    {
+        float y = Seed::guess(x);
+        for (int i = 0; i < Steps; ++i)
+        {
+            if constexpr (Seed::Inverse)
+            {
+                y = Refinement::inverseStep(x, y);
+            }
+            else
+            {
+                y = Refinement::step(x, y);
+            }
+        }
+        if constexpr (Seed::Inverse)
+        {
+            return x * y;
+        }
+        else
+        {
+            return y;
+        }
+    }
+};
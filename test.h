@@ -1,23 +1,273 @@
 #pragma once
 
+#include "bitops.h"
+#include "float16.h"
+#include "fpmode.h"
+#include "fuzz.h"
+#include "perf.h"
+#include "plugin.h"
 #include "result.h"
+#include "validity.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <functional>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <math.h>
 #include <numeric>
+#include <random>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <vector>
 
+/// @brief Number of values a test function returns. 1 for scalars, N for std::pair or std::tuple outputs, e.g. sincos.
+template <typename T>
+struct OutputSize : std::integral_constant<std::size_t, 1>
+{
+};
+
+template <typename A, typename B>
+struct OutputSize<std::pair<A, B>> : std::integral_constant<std::size_t, 2>
+{
+};
+
+template <typename... Ts>
+struct OutputSize<std::tuple<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)>
+{
+};
+
+/// @brief Convert a scalar, std::pair or std::tuple output to an array of values.
+template <typename StorageT, typename T>
+std::array<StorageT, OutputSize<T>::value> outputValues(const T& v)
+{
+    if constexpr (OutputSize<T>::value == 1)
+    {
+        return {static_cast<StorageT>(v)};
+    }
+    else
+    {
+        return std::apply([](const auto&... c)
+                          { return std::array<StorageT, OutputSize<T>::value>{static_cast<StorageT>(c)...}; },
+                          v);
+    }
+}
+
+/// @brief Type of the (first) value a test function returns.
+template <typename T>
+struct OutputElement
+{
+    using type = T;
+};
+
+template <typename A, typename B>
+struct OutputElement<std::pair<A, B>>
+{
+    using type = A;
+};
+
+template <typename T, typename... Ts>
+struct OutputElement<std::tuple<T, Ts...>>
+{
+    using type = T;
+};
+
+/// @brief Size of a unit in the last place (ULP) of v in the output type T, i.e. the spacing of the values of T around v.
+/// Returns 1 for integer and fixed-point types, so the ULP error is the error in LSBs.
+/// See: https://en.wikipedia.org/wiki/Unit_in_the_last_place
+template <typename T, typename StorageT>
+StorageT ulp(const StorageT v)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        return 1;
+    }
+    else
+    {
+        int digits = 0;
+        int minExponent = 0;
+        if constexpr (std::is_floating_point<T>::value && sizeof(T) >= sizeof(float))
+        {
+            digits = std::numeric_limits<T>::digits;
+            minExponent = std::numeric_limits<T>::min_exponent;
+        }
+        else
+        {
+            // 16-bit floating-point types. the smallest normal value is 2^(1 - bias) = 0.5 * 2^(2 - bias)
+            digits = Float16Traits<T>::MantissaBits + 1;
+            minExponent = 2 - Float16Traits<T>::ExponentBias;
+        }
+        // frexp returns v = m * 2^e with m in [0.5, 1). denormals have the same ULP as the smallest normal value
+        int e = minExponent;
+        if (v != 0)
+        {
+            std::frexp(v, &e);
+            e = std::max(e, minExponent);
+        }
+        return std::ldexp(StorageT(1), e - digits);
+    }
+}
+
+/// @brief Sum up all values of an output, so they can be stored to a single volatile variable and are not optimized away.
+template <typename StorageT, typename T>
+StorageT outputSum(const T& v)
+{
+    if constexpr (OutputSize<T>::value == 1)
+    {
+        return static_cast<StorageT>(v);
+    }
+    else
+    {
+        return std::apply([](const auto&... c)
+                          { return (static_cast<StorageT>(c) + ...); },
+                          v);
+    }
+}
+
+/// @brief Convert an input value to T. Uses the first value of pairs and tuples.
+template <typename T, typename InputT>
+T inputAs(const InputT& x)
+{
+    if constexpr (OutputSize<InputT>::value == 1)
+    {
+        return static_cast<T>(x);
+    }
+    else
+    {
+        return static_cast<T>(std::get<0>(x));
+    }
+}
+
+/// @brief Baseline for a test function of type R(InputT) to measure the overhead of the benchmark loop: It is called the
+/// same way, loads the same input, converts it to the same output type and stores all values of it, but calculates nothing.
+/// Its time is subtracted from the time of the function. See Test::measureLoops().
+template <typename R, typename InputT>
+R baselineFunc(const InputT x)
+{
+    if constexpr (OutputSize<R>::value == 1)
+    {
+        return inputAs<R>(x);
+    }
+    else
+    {
+        return std::apply([&x](const auto&... c)
+                          { return R{inputAs<std::decay_t<decltype(c)>>(x)...}; },
+                          R{});
+    }
+}
+
+/// @brief Baseline for a batch function of type void(const InputT* x, OutputT* y, std::size_t count). See baselineFunc().
+/// Uses memcpy if the types are the same, so it is as fast as the widest loads and stores the CPU has, like SIMD functions.
+template <typename OutputT, typename InputT>
+void baselineBatchFunc(const InputT* x, OutputT* y, std::size_t count)
+{
+    if constexpr (std::is_same<InputT, OutputT>::value && std::is_trivially_copyable<InputT>::value)
+    {
+        std::memcpy(y, x, count * sizeof(InputT));
+    }
+    else
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            y[i] = baselineFunc<OutputT>(x[i]);
+        }
+    }
+}
+
+/// @brief Get the bucket of an input value for per-binade statistics: Floating-point values are grouped by binade [2^n, 2^(n+1))
+/// and integers by bit length, which is the same for integers. Negative values get their own buckets and so do 0 and inf / NaN.
+/// Returns a key that sorts buckets by input value and a label, or false for types without buckets (e.g. std::tuple).
+template <typename T>
+bool inputBucket(const T& x, int& key, std::string& label)
+{
+    // keys: 0 for zero, +-(n + 2000) for binade n, +-1000000 for inf and NaN
+    auto binade = [&key, &label](bool negative, int n)
+    {
+        key = negative ? -(n + 2000) : (n + 2000);
+        label = std::string(negative ? "-" : "") + "[2^" + std::to_string(n) + ", 2^" + std::to_string(n + 1) + ")";
+    };
+    if constexpr (std::is_integral<T>::value)
+    {
+        using U = typename std::make_unsigned<T>::type;
+        const bool negative = x < 0;
+        // negate as unsigned, so the minimum signed value works too
+        const U magnitude = negative ? U(U(0) - static_cast<U>(x)) : static_cast<U>(x);
+        key = 0;
+        label = "0";
+        if (magnitude != 0)
+        {
+            binade(negative, bitLength(magnitude) - 1);
+        }
+        return true;
+    }
+    else if constexpr (std::is_floating_point<T>::value && sizeof(T) >= sizeof(float))
+    {
+        // use the bits, because -ffast-math assumes there are no inf / NaN and DAZ makes denormals compare equal to 0
+        using U = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+        U u;
+        std::memcpy(&u, &x, sizeof(u));
+        constexpr U signBit = U(1) << (sizeof(U) * 8 - 1);
+        constexpr U exponentMask = ((U(1) << (sizeof(U) * 8 - std::numeric_limits<T>::digits)) - 1) << (std::numeric_limits<T>::digits - 1);
+        const bool negative = (u & signBit) != 0;
+        if ((u & ~signBit) == 0)
+        {
+            key = 0;
+            label = "0";
+        }
+        else if ((u & exponentMask) == exponentMask)
+        {
+            key = negative ? -1000000 : 1000000;
+            label = negative ? "-inf / NaN" : "inf / NaN";
+        }
+        else
+        {
+            // ilogb() works for denormals too
+            binade(negative, std::ilogb(x));
+        }
+        return true;
+    }
+    else if constexpr (std::is_convertible<T, float>::value)
+    {
+        // 16-bit floating-point types, e.g. half_t or bfloat16
+        return inputBucket(static_cast<float>(x), key, label);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/// @brief Settings for all test suites, set from the command line.
+struct TestSettings
+{
+    static inline bool compareInputOrders = false; // also time all functions with the input values sorted, shuffled and in alternating order
+    static inline bool compareFloatModes = false; // also time and check all functions with all floating-point modes from floatModes()
+    static inline bool bucketStatistics = false; // also calculate errors and time per input binade (see inputBucket())
+    static inline double validityThreshold = 0; // if > 0, search the longest interval of float / double inputs where the relative error is <= this value
+    static inline double minTime = 0.1; // minimum time per measurement [s]. Loops are repeated until the time per loop is precise enough
+    static inline double maxTime = 2.0; // maximum time per measurement [s], even if the time per loop is not precise enough yet
+    static inline double targetPrecision = 0.01; // relative standard error of the time per loop to reach
+    static inline uint64_t fuzzInputs = 0; // if > 0, check this many random inputs per approximation against the reference (see fuzz.h)
+    static inline double fuzzTolerance = 2; // the fuzzer allows this factor times the max. errors of fuzzBaselines
+    static inline double fuzzMaxUlpError = 0; // if > 0, the fuzzer fails results with a larger error in ULPs of the output type
+    static inline uint64_t fuzzSeed = 42; // seed of the random inputs of the fuzzer
+    static inline std::vector<FuzzBaseline> fuzzBaselines; // max. errors recorded by a trusted run, read from --fuzz-baseline
+};
+
 /// @brief Test suite base class. Use to derive test suites from.
-/// @tparam InputT Test input variable type (e.g. float, int or std::pair<float, float>).
-/// @tparam OutputT Test output type (e.g. float).
+/// @tparam InputT Test input variable type (e.g. float, int, half_t, bfloat16 or std::pair<float, float>).
+/// @tparam OutputT Test output type (e.g. float or std::pair<float, float> for functions returning multiple values).
+/// For multiple values the error of a call is the maximum error of all values.
 /// @tparam StorageT Type the results are stored in. Use a wider type for storing results with increased precision (e.g double).
-template <typename InputT, typename OutputT, typename StorageT = OutputT>
+/// @tparam UlpT Type the ULP error is measured in. Set it if the output is calculated in a wider type than the function
+/// works in, e.g. float for a length of float vectors that is returned as double.
+template <typename InputT, typename OutputT, typename StorageT = OutputT, typename UlpT = typename OutputElement<OutputT>::type>
 class Test
 {
   public:
@@ -26,34 +276,92 @@ class Test
     using input_generator_t = std::function<std::vector<input_t>(const input_range_t&, uint64_t)>;
     using output_t = OutputT;
     using storage_t = StorageT;
+    using ulp_t = UlpT;
     using storage_range_t = std::pair<storage_t, storage_t>;
 
-    template <typename ReferenceFunction, typename DummyFunction>
-    Test(const std::string& suiteName, input_generator_t inputGenerator, input_range_t inputRange, uint64_t samplesInRange, ReferenceFunction refFunc, DummyFunction dummyFunc)
+    template <typename ReferenceFunction>
+    Test(const std::string& suiteName, input_generator_t inputGenerator, input_range_t inputRange, uint64_t samplesInRange, ReferenceFunction refFunc)
         : m_suiteName(suiteName), m_inputRange(inputRange), m_inputValues(inputGenerator(inputRange, samplesInRange))
     {
         // generate reference result values
         const input_t* inputData = m_inputValues.data();
         for (uint_fast64_t i = 0; i < m_inputValues.size(); ++i)
         {
-            m_referenceValues.push_back(refFunc(inputData[i]));
+            m_referenceValues.push_back(outputValues<storage_t>(refFunc(inputData[i])));
         }
-        // make sure we use a volatile destination, so values are not thrown away.
-        volatile storage_t dummy{};
-        // "calibrate" the speed loop
-        auto startCalib = std::chrono::high_resolution_clock::now();
-        for (uint_fast64_t j = 0; j < LOOPCOUNT; ++j)
+        m_referenceFunction = [refFunc](const input_t& x)
+        {
+            return outputValues<storage_t>(refFunc(x));
+        };
+        if (TestSettings::compareInputOrders)
         {
-            for (uint_fast64_t i = 0; i < m_inputValues.size(); ++i)
+            m_orderedInputValues = orderInputValues(m_inputValues);
+        }
+        if (TestSettings::bucketStatistics)
+        {
+            m_buckets = bucketInputValues(m_inputValues);
+        }
+    }
+
+    /// @brief Run the kernels loaded from plugins (see plugin.h) that name functionName as suite and add their results.
+    /// The scalar and batch functions of a kernel are run like the built-in approximations. Kernels with other input or
+    /// output types than the suite are skipped. Kernels without a description get the one of the result with the same name.
+    void runPlugins(const std::string& functionName, std::vector<Result<input_t, storage_t>>& results) const
+    {
+        for (const auto& pluginKernel : PluginSettings::kernels)
+        {
+            const auto& kernel = pluginKernel.kernel;
+            if (functionName != kernel.suite)
             {
-                dummy = dummyFunc(inputData[i]);
+                continue;
+            }
+            const std::string name = pluginKernel.label + ":" + kernel.name;
+            if constexpr (approxType<input_t>() != 0 && approxType<output_t>() != 0)
+            {
+                if (kernel.inputType != approxType<input_t>() || kernel.outputType != approxType<output_t>())
+                {
+                    std::cout << "Skipping plugin kernel " << name << ": Input / output types do not match suite " << functionName << std::endl;
+                    continue;
+                }
+                if (kernel.validMin < kernel.validMax && (double(m_inputRange.first) < kernel.validMin || double(m_inputRange.second) > kernel.validMax))
+                {
+                    std::cout << "Note: Plugin kernel " << name << " is only valid for [" << kernel.validMin << ", " << kernel.validMax << "], expect large errors outside" << std::endl;
+                }
+                std::string description = kernel.description != nullptr ? kernel.description : "";
+                auto builtIn = std::find_if(results.cbegin(), results.cend(), [&kernel](const Result<input_t, storage_t>& r)
+                                            { return r.name == kernel.name; });
+                if (description.empty() && builtIn != results.cend())
+                {
+                    description = builtIn->description;
+                }
+                if (kernel.scalar != nullptr)
+                {
+                    results.push_back(run(name, description, reinterpret_cast<output_t (*)(input_t)>(kernel.scalar)));
+                }
+                if (kernel.batch != nullptr)
+                {
+                    auto batch = kernel.batch;
+                    results.push_back(runBatch(kernel.scalar != nullptr ? name + " batch" : name, description, [batch](const input_t* x, output_t* y, std::size_t count)
+                                               { batch(x, y, count); }));
+                    results.back().kernelAddress = reinterpret_cast<const void*>(batch);
+                }
+            }
+            else
+            {
+                std::cout << "Skipping plugin kernel " << name << ": Suite " << functionName << " does not support plugins" << std::endl;
             }
         }
-        auto overheadDuration = std::chrono::high_resolution_clock::now() - startCalib;
-        m_overheadNs = std::chrono::duration_cast<std::chrono::nanoseconds>(overheadDuration).count() / LOOPCOUNT;
     }
 
   protected:
+    /// @brief Input values of a bucket for per-binade statistics. See inputBucket().
+    struct InputBucket
+    {
+        std::string label;
+        std::vector<std::size_t> indices; // indices of the values in m_inputValues
+        std::vector<input_t> timingValues; // values repeated to at least MIN_BUCKET_CALLS values, so the time is precise enough
+    };
+
     static storage_range_t minmax(const std::vector<storage_t>& values)
     {
         // calculate min / max percentage range of values
@@ -81,12 +389,18 @@ class Test
         return std::accumulate(values.cbegin(), values.cend(), storage_t()) / values.size();
     }
 
-    static storage_t median(const std::vector<storage_t>& values)
+    /// @brief Return the values at 0%, 1%, ..., 100% of the sorted values. The median is at 50%.
+    /// Calculated once here, so plotting does not need to sort the values again.
+    static std::vector<storage_t> percentiles(const std::vector<storage_t>& values)
     {
         std::vector<storage_t> sortvalues = values;
-        std::nth_element(sortvalues.begin(), sortvalues.begin() + sortvalues.size() / 2, sortvalues.end());
-        auto medianIt = sortvalues.cbegin() + sortvalues.size() / 2;
-        return *medianIt;
+        std::sort(sortvalues.begin(), sortvalues.end());
+        std::vector<storage_t> result;
+        for (std::size_t p = 0; p <= 100; ++p)
+        {
+            result.push_back(sortvalues[std::min(sortvalues.size() - 1, sortvalues.size() * p / 100)]);
+        }
+        return result;
     }
 
     static storage_t variance(const std::vector<storage_t>& values)
@@ -100,12 +414,26 @@ class Test
         errors.minimum = minmaxValue.first;
         errors.maximum = minmaxValue.second;
         errors.mean = mean(errors.values);
-        errors.median = median(errors.values);
+        errors.percentiles = percentiles(errors.values);
+        errors.median = errors.percentiles[50];
         errors.variance = variance(errors.values);
     }
 
+    /// @brief Address of an approximation if it is a function pointer, otherwise nullptr. See mca.h.
     template <typename Approximation>
-    Result<input_t, storage_t> run(const std::string& name, const std::string& description, Approximation approx) const
+    static const void* kernelAddress(Approximation approx)
+    {
+        if constexpr (std::is_pointer<Approximation>::value)
+        {
+            return reinterpret_cast<const void*>(approx);
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    Result<input_t, storage_t> createResult(const std::string& name, const std::string& description) const
     {
         Result<input_t, storage_t> result;
         result.suiteName = m_suiteName;
@@ -113,46 +441,601 @@ class Test
         result.description = description;
         result.inputRange = m_inputRange;
         result.samplesInRange = m_inputValues.size();
-        result.overheadNs = m_overheadNs;
+        result.inputValues = m_inputValues;
+        return result;
+    }
+
+    void calculateErrors(Result<input_t, storage_t>& result, const std::vector<output_t>& approxValues) const
+    {
+        for (uint_fast64_t i = 0; i < result.samplesInRange; ++i)
+        {
+            const auto as = outputValues<storage_t>(approxValues[i]);
+            const auto& vs = m_referenceValues[i];
+            result.values.push_back(as[0]);
+            // calculate absolute and relative errors. use the worst value for multi-value outputs
+            storage_t absoluteError = abs(as[0] - vs[0]);
+            storage_t relativeError = vs[0] != 0.0 ? abs(1.0 - as[0] / vs[0]) : 0.0;
+            storage_t ulpError = abs(as[0] - vs[0]) / ulp<ulp_t>(vs[0]);
+            for (std::size_t j = 1; j < as.size(); ++j)
+            {
+                const storage_t a = as[j];
+                const storage_t v = vs[j];
+                absoluteError = std::max<storage_t>(absoluteError, abs(a - v));
+                relativeError = std::max<storage_t>(relativeError, v != 0.0 ? abs(1.0 - a / v) : 0.0);
+                ulpError = std::max<storage_t>(ulpError, abs(a - v) / ulp<ulp_t>(v));
+            }
+            result.absoluteErrors.values.push_back(absoluteError);
+            result.relativeErrors.values.push_back(relativeError);
+            result.maxUlpError = std::max(result.maxUlpError, ulpError);
+        }
+        result.valuePercentiles = percentiles(result.values);
+        // calculate error statistics
+        calculateErrorStatistics(result.absoluteErrors);
+        calculateErrorStatistics(result.relativeErrors);
+        // calculate stddev
+        result.stddev = stddev(result.absoluteErrors.values);
+    }
+
+    /// @brief Create copies of the input values sorted ascending, randomly shuffled and in alternating order
+    /// smallest, largest, 2nd smallest, 2nd largest, ... The alternating order flips the result of comparisons with a threshold
+    /// and switches between short and long loops on every call. Predictors using the branch history can learn such a short
+    /// pattern though, so the shuffled order is often the slowest.
+    static std::vector<std::pair<std::string, std::vector<input_t>>> orderInputValues(const std::vector<input_t>& values)
+    {
+        std::vector<input_t> sorted = values;
+        std::sort(sorted.begin(), sorted.end(), [](const input_t& a, const input_t& b)
+                  {
+                      // compare bits, so NaNs from the "special" input generator do not break sorting
+                      if constexpr (std::is_floating_point<input_t>::value && sizeof(input_t) >= sizeof(float))
+                      {
+                          return totalOrderBits(a) < totalOrderBits(b);
+                      }
+                      else
+                      {
+                          return a < b;
+                      }
+                  });
+        std::vector<input_t> shuffled = sorted;
+        std::mt19937_64 mt(42);
+        std::shuffle(shuffled.begin(), shuffled.end(), mt);
+        std::vector<input_t> alternating;
+        for (std::size_t lo = 0, hi = sorted.size(); lo < hi; ++lo)
+        {
+            alternating.push_back(sorted[lo]);
+            if (lo < --hi)
+            {
+                alternating.push_back(sorted[hi]);
+            }
+        }
+        return {{"sorted", sorted}, {"shuffled", shuffled}, {"alternating", alternating}};
+    }
+
+    /// @brief Group the input values by inputBucket(). Returns no buckets if the input type has none.
+    static std::vector<InputBucket> bucketInputValues(const std::vector<input_t>& values)
+    {
+        std::map<int, InputBucket> buckets;
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            int key = 0;
+            std::string label;
+            if (!inputBucket(values[i], key, label))
+            {
+                return {};
+            }
+            auto& bucket = buckets[key];
+            bucket.label = label;
+            bucket.indices.push_back(i);
+        }
+        std::vector<InputBucket> result;
+        for (auto& keyAndBucket : buckets)
+        {
+            auto& bucket = keyAndBucket.second;
+            while (bucket.timingValues.size() < MIN_BUCKET_CALLS)
+            {
+                for (const auto i : bucket.indices)
+                {
+                    bucket.timingValues.push_back(values[i]);
+                }
+            }
+            result.push_back(std::move(bucket));
+        }
+        return result;
+    }
+
+    /// @brief Times per loop measured by measureLoops().
+    struct LoopTiming
+    {
+        uint64_t callNs = 0; // mean time of the measured code
+        uint64_t overheadNs = 0; // mean time of the baseline
+        double uncertaintyNs = 0; // standard error of callNs - overheadNs
+        bool hasBranchMisses = false; // true if branch mispredictions could be measured
+        uint64_t branchMisses = 0; // branch mispredictions of the measured code per loop
+    };
+
+    /// @brief Store the time measured by measureLoops() in a result.
+    static void setTiming(Result<input_t, storage_t>& result, const LoopTiming& timing)
+    {
+        result.callNs = timing.callNs;
+        result.overheadNs = timing.overheadNs;
+        result.uncertaintyNs = timing.uncertaintyNs;
+        result.hasBranchMisses = timing.hasBranchMisses;
+        result.branchMisses = timing.branchMisses;
+    }
+
+    static typename Result<input_t, storage_t>::OrderTiming orderTiming(const std::string& order, const LoopTiming& timing)
+    {
+        typename Result<input_t, storage_t>::OrderTiming result;
+        result.order = order;
+        result.callNs = timing.callNs;
+        result.overheadNs = timing.overheadNs;
+        result.branchMisses = timing.branchMisses;
+        return result;
+    }
+
+    /// @brief Calculate errors and time per input bucket if TestSettings::bucketStatistics is set. Must be called after calculateErrors().
+    /// @param measure Function of type LoopTiming(const std::vector<input_t>& values) that measures the time for some input values.
+    template <typename Measure>
+    void measureBuckets(Result<input_t, storage_t>& result, Measure measure) const
+    {
+        for (const auto& bucketInputs : m_buckets)
+        {
+            typename Result<input_t, storage_t>::Bucket bucket;
+            bucket.label = bucketInputs.label;
+            bucket.samples = bucketInputs.indices.size();
+            for (const auto i : bucketInputs.indices)
+            {
+                bucket.maxAbsoluteError = std::max(bucket.maxAbsoluteError, result.absoluteErrors.values[i]);
+                bucket.meanAbsoluteError += result.absoluteErrors.values[i];
+                bucket.maxRelativeError = std::max(bucket.maxRelativeError, result.relativeErrors.values[i]);
+                bucket.meanRelativeError += result.relativeErrors.values[i];
+            }
+            bucket.meanAbsoluteError /= bucket.samples;
+            bucket.meanRelativeError /= bucket.samples;
+            bucket.calls = bucketInputs.timingValues.size();
+            const auto timing = measure(bucketInputs.timingValues);
+            bucket.callNs = timing.callNs;
+            bucket.overheadNs = timing.overheadNs;
+            result.buckets.push_back(bucket);
+        }
+    }
+
+    /// @brief Measure the time of some code and of a baseline that has the same overhead, but does not do the actual work.
+    /// Both are run in every round with the same number of loops and the order is swapped every round, so changes of the clock
+    /// frequency or other load on the machine affect both the same way. The difference of the two times is calculated per
+    /// round. Rounds are run until TestSettings::minTime has passed and the standard error of the mean difference is
+    /// <= TestSettings::targetPrecision * the mean time of the code, or until TestSettings::maxTime has passed. The number of loops
+    /// per round is doubled until a round takes at least 1/10 of the minimum time, so the clock resolution does not matter.
+    /// These rounds also warm up caches and the branch predictor and are not used for the time.
+    /// See: https://en.wikipedia.org/wiki/Standard_error
+    /// @param runLoops Function of type void(uint_fast64_t loopCount) that runs the measured code loopCount times.
+    /// @param runBaselineLoops Function of type void(uint_fast64_t loopCount) that runs the baseline loopCount times.
+    /// @param branchMissCounter If not nullptr, counts the branch mispredictions of the measured code (not of the baseline).
+    template <typename RunLoops, typename RunBaselineLoops>
+    static LoopTiming measureLoops(RunLoops runLoops, RunBaselineLoops runBaselineLoops, PerfCounter* branchMissCounter = nullptr)
+    {
+        const double minNs = TestSettings::minTime * 1e9;
+        const double maxNs = TestSettings::maxTime * 1e9;
+        auto timeRound = [](auto run, uint_fast64_t loopCount)
+        {
+            auto startRound = std::chrono::high_resolution_clock::now();
+            run(loopCount);
+            return double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - startRound).count());
+        };
+        uint_fast64_t roundLoops = 1;
+        uint64_t branchMisses = 0;
+        auto measureRound = [&]()
+        {
+            if (branchMissCounter != nullptr)
+            {
+                branchMissCounter->start();
+            }
+            const double ns = timeRound(runLoops, roundLoops);
+            if (branchMissCounter != nullptr)
+            {
+                branchMisses += branchMissCounter->stop();
+            }
+            return ns;
+        };
+        double totalNs = 0;
+        uint_fast64_t loops = 0; // loops of the measured code, including warm-up
+        std::vector<double> differenceNs; // time per loop of the measured code - time per loop of the baseline per round
+        double measuredNs = 0;
+        double baselineNs = 0;
+        uint_fast64_t measuredLoops = 0;
+        LoopTiming timing;
+        for (uint_fast64_t round = 0;; ++round)
+        {
+            double ns = 0;
+            double overheadNs = 0;
+            if (round % 2 == 0)
+            {
+                ns = measureRound();
+                overheadNs = timeRound(runBaselineLoops, roundLoops);
+            }
+            else
+            {
+                overheadNs = timeRound(runBaselineLoops, roundLoops);
+                ns = measureRound();
+            }
+            totalNs += ns + overheadNs;
+            loops += roundLoops;
+            if (ns < minNs / 10 && differenceNs.empty())
+            {
+                roundLoops *= 2;
+            }
+            else
+            {
+                differenceNs.push_back((ns - overheadNs) / double(roundLoops));
+                measuredNs += ns;
+                baselineNs += overheadNs;
+                measuredLoops += roundLoops;
+            }
+            if (totalNs >= maxNs && measuredLoops == 0)
+            {
+                // a single loop takes longer than maxTime
+                timing.callNs = uint64_t(ns / double(roundLoops));
+                timing.overheadNs = uint64_t(overheadNs / double(roundLoops));
+                break;
+            }
+            if (totalNs >= maxNs || (totalNs >= minNs && differenceNs.size() >= 3))
+            {
+                const double meanNs = measuredNs / double(measuredLoops);
+                const double meanDifferenceNs = (measuredNs - baselineNs) / double(measuredLoops);
+                double sumOfSquares = 0;
+                for (const auto d : differenceNs)
+                {
+                    sumOfSquares += (d - meanDifferenceNs) * (d - meanDifferenceNs);
+                }
+                const double standardError = differenceNs.size() > 1 ? std::sqrt(sumOfSquares / double(differenceNs.size() - 1) / double(differenceNs.size())) : meanNs;
+                if (totalNs >= maxNs || standardError <= TestSettings::targetPrecision * meanNs)
+                {
+                    timing.callNs = uint64_t(meanNs);
+                    timing.overheadNs = uint64_t(baselineNs / double(measuredLoops));
+                    timing.uncertaintyNs = standardError;
+                    break;
+                }
+            }
+        }
+        // the code does at least as much as the baseline, so a time clearly below it means the baseline is off, e.g. by
+        // noise. never report a negative time that is not covered by the uncertainty
+        timing.overheadNs = std::min(timing.overheadNs, timing.callNs + uint64_t(timing.uncertaintyNs));
+        if (branchMissCounter != nullptr)
+        {
+            timing.hasBranchMisses = branchMissCounter->isValid();
+            timing.branchMisses = branchMisses / loops;
+        }
+        return timing;
+    }
+
+    /// @brief Call func for all count input values loopCount times and store the results in dummy.
+    template <typename Function>
+    static void callLoops(Function func, const input_t* inputData, uint_fast64_t count, uint_fast64_t loopCount, volatile storage_t& dummy)
+    {
+        for (uint_fast64_t j = 0; j < loopCount; ++j)
+        {
+            for (uint_fast64_t i = 0; i < count; ++i)
+            {
+                dummy = outputSum<storage_t>(func(inputData[i]));
+            }
+        }
+    }
+
+    /// @brief Call approx for all input values until the time is precise enough (see measureLoops()) and measure the time
+    /// and branch mispredictions per loop. The baseline is baselineFunc() with the same signature as approx.
+    /// Both are called through a function pointer by the same instance of callLoops(), which is itself called through a
+    /// pointer the compiler can not see through, so it is not inlined. This way the approximation and the baseline are
+    /// timed with exactly the same machine code and call overhead, and only the called function differs.
+    template <typename Approximation>
+    LoopTiming measureCalls(Approximation approx, const std::vector<input_t>& values) const
+    {
+        using approx_output_t = decltype(approx(std::declval<input_t>()));
+        using function_t = approx_output_t (*)(input_t);
+        using call_loops_t = void (*)(function_t, const input_t*, uint_fast64_t, uint_fast64_t, volatile storage_t&);
+        const function_t function = approx;
+        const function_t baseline = &baselineFunc<approx_output_t, input_t>;
+        volatile call_loops_t opaqueCallLoops = &callLoops<function_t>;
+        const call_loops_t runCallLoops = opaqueCallLoops;
         // make sure we use a volatile destination, so values are not thrown away.
         volatile storage_t dummy{};
-        const input_t* inputData = m_inputValues.data();
-        // start speed measurement
-        auto startSpeed = std::chrono::high_resolution_clock::now();
-        for (uint_fast64_t j = 0; j < LOOPCOUNT; ++j)
+        const input_t* inputData = values.data();
+        const uint_fast64_t count = values.size();
+        PerfCounter branchMissCounter(PerfCounter::Event::BranchMisses);
+        return measureLoops([&](uint_fast64_t loopCount)
+                            { runCallLoops(function, inputData, count, loopCount, dummy); },
+                            [&](uint_fast64_t loopCount)
+                            { runCallLoops(baseline, inputData, count, loopCount, dummy); },
+                            &branchMissCounter);
+    }
+
+    /// @brief Call batchApprox for all input values until the time is precise enough (see measureLoops()) and measure the time
+    /// and branch mispredictions per loop. The baseline is baselineBatchFunc(), which only converts and copies the values.
+    template <typename BatchApproximation>
+    LoopTiming measureBatchCalls(BatchApproximation batchApprox, const std::vector<input_t>& values, std::vector<output_t>& approxValues) const
+    {
+        auto baseline = &baselineBatchFunc<output_t, input_t>;
+        std::vector<output_t> baselineValues(values.size());
+        PerfCounter branchMissCounter(PerfCounter::Event::BranchMisses);
+        return measureLoops([&](uint_fast64_t loopCount)
+                            {
+                                for (uint_fast64_t j = 0; j < loopCount; ++j)
+                                {
+                                    batchApprox(values.data(), approxValues.data(), values.size());
+                                }
+                            },
+                            [&](uint_fast64_t loopCount)
+                            {
+                                for (uint_fast64_t j = 0; j < loopCount; ++j)
+                                {
+                                    baseline(values.data(), baselineValues.data(), values.size());
+                                }
+                            },
+                            &branchMissCounter);
+    }
+
+    /// @brief Time and check an approximation with all floating-point modes if TestSettings::compareFloatModes is set.
+    /// @param evaluate Function of type LoopTiming(std::vector<output_t>& approxValues) that measures the time
+    /// for all input values and stores the approximate values. It is called with the mode set.
+    template <typename Evaluate>
+    void measureFloatModes(Result<input_t, storage_t>& result, Evaluate evaluate) const
+    {
+        if (!TestSettings::compareFloatModes || !floatModesSupported())
+        {
+            return;
+        }
+        for (const auto& mode : floatModes())
+        {
+            typename Result<input_t, storage_t>::ModeResult modeResult;
+            modeResult.mode = mode.name;
+            std::vector<output_t> approxValues(m_inputValues.size());
+            {
+                ScopedFloatMode scopedMode(mode);
+                const auto timing = evaluate(approxValues);
+                modeResult.callNs = timing.callNs;
+                modeResult.overheadNs = timing.overheadNs;
+            }
+            // calculate errors in the default mode, so they are not affected by the mode
+            auto modeErrors = createResult(result.name, result.description);
+            calculateErrors(modeErrors, approxValues);
+            modeResult.maxAbsoluteError = modeErrors.absoluteErrors.maximum;
+            modeResult.maxRelativeError = modeErrors.relativeErrors.maximum;
+            result.modeResults.push_back(modeResult);
+        }
+    }
+
+    /// @brief Search the longest interval of input values where the relative error is <= TestSettings::validityThreshold
+    /// if it is set. Only float and double inputs are supported. Where the reference value is 0 the absolute error is used,
+    /// where it is inf or NaN the input is invalid.
+    /// @param evaluate Function of type std::vector<output_t>(const std::vector<input_t>& values) that returns the approximate values.
+    /// It is called from multiple threads at the same time.
+    template <typename Evaluate>
+    void measureValidRange(Result<input_t, storage_t>& result, Evaluate evaluate) const
+    {
+        if constexpr (std::is_floating_point<input_t>::value && (sizeof(input_t) == sizeof(float) || sizeof(input_t) == sizeof(double)))
+        {
+            const double threshold = TestSettings::validityThreshold;
+            if (threshold <= 0)
+            {
+                return;
+            }
+            auto check = [&](const std::vector<input_t>& values)
+            {
+                const auto approxValues = evaluate(values);
+                std::vector<char> valid(values.size());
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    const auto as = outputValues<storage_t>(approxValues[i]);
+                    const auto vs = m_referenceFunction(values[i]);
+                    bool isValid = true;
+                    // check the bits, because -ffast-math assumes there are no NaNs and inf in comparisons.
+                    // a non-finite reference means the input is outside the domain of the function, so it is never valid
+                    auto isFinite = [](const double v)
+                    {
+                        uint64_t bits;
+                        std::memcpy(&bits, &v, sizeof(bits));
+                        return ((bits >> 52) & 0x7FF) != 0x7FF;
+                    };
+                    for (std::size_t j = 0; j < as.size(); ++j)
+                    {
+                        if (!isFinite(static_cast<double>(vs[j])))
+                        {
+                            isValid = false;
+                            break;
+                        }
+                        const storage_t error = vs[j] != 0.0 ? abs(1.0 - as[j] / vs[j]) : abs(as[j] - vs[j]);
+                        const double e = static_cast<double>(error);
+                        isValid = isValid && isFinite(e) && e <= threshold;
+                    }
+                    valid[i] = isValid ? 1 : 0;
+                }
+                return valid;
+            };
+            result.validityThreshold = threshold;
+            result.hasValidRange = findValidRange<input_t>(check, result.validRange);
+        }
+    }
+
+    /// @brief Fuzz an approximation against the reference if TestSettings::fuzzInputs > 0 (see fuzz.h). An input fails if
+    /// the result is not finite, if its error is larger than TestSettings::fuzzMaxUlpError ULPs (if set) or if both its
+    /// relative and absolute error are larger than TestSettings::fuzzTolerance times the errors of its baseline (if any).
+    /// @param evaluate Function of type std::vector<output_t>(const std::vector<input_t>& values). Called from multiple threads.
+    template <typename Evaluate>
+    void fuzzApproximation(Result<input_t, storage_t>& result, Evaluate evaluate) const
+    {
+        if constexpr (fuzzSupported<input_t>())
         {
-            for (uint_fast64_t i = 0; i < result.samplesInRange; ++i)
+            if (TestSettings::fuzzInputs == 0)
+            {
+                return;
+            }
+            // check the bits, because -ffast-math assumes there are no NaNs and inf in comparisons
+            auto isFinite = [](const double v)
+            {
+                uint64_t bits;
+                std::memcpy(&bits, &v, sizeof(bits));
+                return ((bits >> 52) & 0x7FF) != 0x7FF;
+            };
+            const auto baseline = findFuzzBaseline(TestSettings::fuzzBaselines, result.suiteName, result.name);
+            const double relativeTolerance = baseline != nullptr ? TestSettings::fuzzTolerance * baseline->maxRelativeError : 0;
+            const double absoluteTolerance = baseline != nullptr ? TestSettings::fuzzTolerance * baseline->maxAbsoluteError : 0;
+            const bool hasBaseline = baseline != nullptr && isFinite(relativeTolerance) && isFinite(absoluteTolerance);
+            const bool checkUlpError = TestSettings::fuzzMaxUlpError > 0;
+            // index of the first failing value of a call or -1 if all values pass
+            auto failingValue = [&](const input_t& x, const output_t& approxValue)
             {
-                dummy = approx(inputData[i]);
+                const auto as = outputValues<storage_t>(approxValue);
+                const auto vs = m_referenceFunction(x);
+                for (std::size_t j = 0; j < as.size(); ++j)
+                {
+                    const double a = static_cast<double>(as[j]);
+                    const double v = static_cast<double>(vs[j]);
+                    if (std::memcmp(&a, &v, sizeof(a)) == 0)
+                    {
+                        continue;
+                    }
+                    const double absoluteError = std::abs(a - v);
+                    const double relativeError = v != 0.0 ? std::abs(1.0 - a / v) : absoluteError;
+                    if (!isFinite(absoluteError) || !isFinite(relativeError) ||
+                        (hasBaseline && relativeError > relativeTolerance && absoluteError > absoluteTolerance) ||
+                        (checkUlpError && absoluteError > TestSettings::fuzzMaxUlpError * double(ulp<ulp_t>(storage_t(v)))))
+                    {
+                        return int(j);
+                    }
+                }
+                return -1;
+            };
+            auto check = [&](const std::vector<input_t>& values)
+            {
+                const auto approxValues = evaluate(values);
+                std::vector<char> failed(values.size());
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    failed[i] = failingValue(values[i], approxValues[i]) >= 0 ? 1 : 0;
+                }
+                return failed;
+            };
+            std::vector<input_t> failingInputs;
+            const auto counts = fuzz<input_t>(check, m_inputRange, TestSettings::fuzzInputs, TestSettings::fuzzSeed, failingInputs);
+            result.fuzzInputs = counts.first;
+            result.fuzzFailures = counts.second;
+            result.fuzzHasBaseline = hasBaseline;
+            result.fuzzRelativeTolerance = storage_t(relativeTolerance);
+            result.fuzzAbsoluteTolerance = storage_t(absoluteTolerance);
+            result.fuzzMaxUlpError = storage_t(TestSettings::fuzzMaxUlpError);
+            const auto failingValues = evaluate(failingInputs);
+            for (std::size_t i = 0; i < failingInputs.size(); ++i)
+            {
+                const auto j = std::max(failingValue(failingInputs[i], failingValues[i]), 0);
+                result.fuzzFailingInputs.push_back({failingInputs[i], outputValues<storage_t>(failingValues[i])[j], m_referenceFunction(failingInputs[i])[j]});
             }
         }
-        auto speedDuration = std::chrono::high_resolution_clock::now() - startSpeed;
-        result.callNs = std::chrono::duration_cast<std::chrono::nanoseconds>(speedDuration).count() / LOOPCOUNT;
+    }
+
+    /// @brief Run an approximation of type output_t(input_t).
+    template <typename Approximation>
+    Result<input_t, storage_t> run(const std::string& name, const std::string& description, Approximation approx) const
+    {
+        auto result = createResult(name, description);
+        result.kernelAddress = kernelAddress(approx);
+        setTiming(result, measureCalls(approx, m_inputValues));
+        for (const auto& orderedValues : m_orderedInputValues)
+        {
+            result.orderTimings.push_back(orderTiming(orderedValues.first, measureCalls(approx, orderedValues.second)));
+        }
         // now check precision
+        const input_t* inputData = m_inputValues.data();
+        std::vector<output_t> approxValues;
         for (uint_fast64_t i = 0; i < result.samplesInRange; ++i)
         {
-            storage_t a = approx(inputData[i]);
-            result.values.push_back(a);
-            // calculate absolute and relative errors
-            auto v = m_referenceValues[i];
-            result.absoluteErrors.values.push_back(abs(a - v));
-            result.relativeErrors.values.push_back(v != 0.0 ? abs(1.0 - a / v) : 0.0);
+            approxValues.push_back(approx(inputData[i]));
         }
-        // calculate error statistics
-        calculateErrorStatistics(result.absoluteErrors);
-        calculateErrorStatistics(result.relativeErrors);
-        // calculate stddev
-        result.stddev = stddev(result.absoluteErrors.values);
+        calculateErrors(result, approxValues);
+        measureBuckets(result, [&](const std::vector<input_t>& values)
+                       { return measureCalls(approx, values); });
+        measureFloatModes(result, [&](std::vector<output_t>& modeValues)
+                          {
+                              const auto timing = measureCalls(approx, m_inputValues);
+                              for (uint_fast64_t i = 0; i < result.samplesInRange; ++i)
+                              {
+                                  modeValues[i] = approx(inputData[i]);
+                              }
+                              return timing;
+                          });
+        measureValidRange(result, [&](const std::vector<input_t>& values)
+                          {
+                              std::vector<output_t> rangeValues;
+                              for (const auto& x : values)
+                              {
+                                  rangeValues.push_back(approx(x));
+                              }
+                              return rangeValues;
+                          });
+        fuzzApproximation(result, [&](const std::vector<input_t>& values)
+                          {
+                              std::vector<output_t> fuzzValues;
+                              for (const auto& x : values)
+                              {
+                                  fuzzValues.push_back(approx(x));
+                              }
+                              return fuzzValues;
+                          });
+        return result;
+    }
+
+    /// @brief Run a batch approximation that processes a whole array of inputs per call.
+    /// @param batchApprox Function of type void(const input_t* x, output_t* y, std::size_t count).
+    template <typename BatchApproximation>
+    Result<input_t, storage_t> runBatch(const std::string& name, const std::string& description, BatchApproximation batchApprox) const
+    {
+        auto result = createResult(name, description);
+        result.kernelAddress = kernelAddress(batchApprox);
+        std::vector<output_t> approxValues(result.samplesInRange);
+        setTiming(result, measureBatchCalls(batchApprox, m_inputValues, approxValues));
+        std::vector<output_t> orderedApproxValues(result.samplesInRange);
+        for (const auto& orderedValues : m_orderedInputValues)
+        {
+            result.orderTimings.push_back(orderTiming(orderedValues.first, measureBatchCalls(batchApprox, orderedValues.second, orderedApproxValues)));
+        }
+        // now check precision
+        calculateErrors(result, approxValues);
+        measureBuckets(result, [&](const std::vector<input_t>& values)
+                       {
+                           std::vector<output_t> bucketValues(values.size());
+                           return measureBatchCalls(batchApprox, values, bucketValues);
+                       });
+        measureFloatModes(result, [&](std::vector<output_t>& modeValues)
+                          { return measureBatchCalls(batchApprox, m_inputValues, modeValues); });
+        measureValidRange(result, [&](const std::vector<input_t>& values)
+                          {
+                              std::vector<output_t> rangeValues(values.size());
+                              batchApprox(values.data(), rangeValues.data(), values.size());
+                              return rangeValues;
+                          });
+        fuzzApproximation(result, [&](const std::vector<input_t>& values)
+                          {
+                              std::vector<output_t> fuzzValues(values.size());
+                              batchApprox(values.data(), fuzzValues.data(), values.size());
+                              return fuzzValues;
+                          });
         return result;
     }
 
+    /// @brief Input values. Use for test suites that need to run approximations in a special way, e.g. on SoA arrays.
+    const std::vector<input_t>& inputValues() const
+    {
+        return m_inputValues;
+    }
+
+    // minimum number of calls per loop when timing the values of a bucket
+    static constexpr uint_fast64_t MIN_BUCKET_CALLS = 1000;
+
   private:
-    static constexpr uint_fast64_t LOOPCOUNT = 10000;
     const std::string m_suiteName;
     const input_range_t m_inputRange{};
     const std::vector<input_t> m_inputValues;
-    std::vector<storage_t> m_referenceValues;
-    uint64_t m_overheadNs = 0;
+    std::vector<std::pair<std::string, std::vector<input_t>>> m_orderedInputValues; // input values in different orders, if TestSettings::compareInputOrders is set
+    std::vector<InputBucket> m_buckets; // input values grouped by binade, if TestSettings::bucketStatistics is set
+    std::vector<std::array<storage_t, OutputSize<output_t>::value>> m_referenceValues;
+    std::function<std::array<storage_t, OutputSize<output_t>::value>(const input_t&)> m_referenceFunction; // reference function for checking values outside of the input range
     volatile input_t m_dummy{};
 };
 
@@ -165,7 +1048,110 @@ std::ostream& operator<<(std::ostream& os, const Result<InputT, StorageT>& r)
     auto& re = r.relativeErrors;
     os << "Relative error: (" << re.minimum << ", " << re.maximum << "), mean: " << re.mean << ", median: " << re.median << ", variance: " << re.variance << std::endl;
     os << "Standard deviation: " << r.stddev << std::endl;
-    os << "Execution time: " << float(r.callNs - r.overheadNs) / float(r.samplesInRange) << " ns / call" << std::endl;
+    os << "Max. ULP error: " << r.maxUlpError << std::endl;
+    const double nsPerCall = r.nsPerCall();
+    os << "Execution time: " << nsPerCall << " +- " << r.nsPerCallUncertainty() << " ns / call (baseline " << double(r.overheadNs) / double(r.samplesInRange) << " ns / call subtracted)" << std::endl;
+    // throughput is meaningless if the time is not clearly above the baseline
+    if (nsPerCall > 2 * r.nsPerCallUncertainty())
+    {
+        os << "Throughput: " << 1000.0 / nsPerCall << " M calls / s" << std::endl;
+    }
+    else
+    {
+        os << "Throughput: not measurable, time is below the precision of the baseline" << std::endl;
+    }
+    if (r.hasBranchMisses)
+    {
+        os << "Branch mispredictions: " << float(r.branchMisses) / float(r.samplesInRange) << " / call" << std::endl;
+    }
+    if (!r.orderTimings.empty())
+    {
+        // slowdown relative to the first (sorted) order
+        const float firstNs = (float(r.orderTimings.front().callNs) - float(r.orderTimings.front().overheadNs)) / float(r.samplesInRange);
+        os << "Input order:";
+        for (const auto& t : r.orderTimings)
+        {
+            const float orderNs = (float(t.callNs) - float(t.overheadNs)) / float(r.samplesInRange);
+            os << (&t == &r.orderTimings.front() ? " " : ", ") << t.order << " " << orderNs << " ns / call";
+            if (&t != &r.orderTimings.front() && firstNs > 0)
+            {
+                os << " (" << orderNs / firstNs << "x)";
+            }
+        }
+        os << std::endl;
+        if (r.hasBranchMisses)
+        {
+            os << "Branch mispredictions by input order:";
+            for (const auto& t : r.orderTimings)
+            {
+                os << (&t == &r.orderTimings.front() ? " " : ", ") << t.order << " " << float(t.branchMisses) / float(r.samplesInRange);
+            }
+            os << " / call" << std::endl;
+        }
+    }
+    if (!r.buckets.empty())
+    {
+        os << "Buckets (input, samples, max. / mean absolute error, max. / mean relative error, time):" << std::endl;
+        for (const auto& b : r.buckets)
+        {
+            os << "  " << b.label << ": " << b.samples << ", " << b.maxAbsoluteError << " / " << b.meanAbsoluteError << ", " << b.maxRelativeError << " / " << b.meanRelativeError << ", ";
+            os << (float(b.callNs) - float(b.overheadNs)) / float(b.calls) << " ns / call" << std::endl;
+        }
+    }
+    if (!r.modeResults.empty())
+    {
+        // slowdown relative to the first mode (FTZ+DAZ)
+        const float firstNs = (float(r.modeResults.front().callNs) - float(r.modeResults.front().overheadNs)) / float(r.samplesInRange);
+        os << "Floating-point modes (time, slowdown, max. absolute / relative error):" << std::endl;
+        for (const auto& m : r.modeResults)
+        {
+            const float modeNs = (float(m.callNs) - float(m.overheadNs)) / float(r.samplesInRange);
+            os << "  " << m.mode << ": " << modeNs << " ns / call";
+            if (firstNs > 0)
+            {
+                os << ", " << modeNs / firstNs << "x";
+            }
+            os << ", " << m.maxAbsoluteError << " / " << m.maxRelativeError << std::endl;
+        }
+    }
+    if (r.fuzzInputs > 0)
+    {
+        os << "Fuzzing: " << r.fuzzFailures << " of " << r.fuzzInputs << " inputs failed (checked: finite results";
+        if (r.fuzzMaxUlpError > 0)
+        {
+            os << ", error <= " << r.fuzzMaxUlpError << " ULPs";
+        }
+        if (r.fuzzHasBaseline)
+        {
+            os << ", relative error <= " << r.fuzzRelativeTolerance << " or absolute error <= " << r.fuzzAbsoluteTolerance << " from the baseline";
+        }
+        os << ")" << std::endl;
+        if constexpr (fuzzSupported<InputT>())
+        {
+            for (const auto& f : r.fuzzFailingInputs)
+            {
+                // all digits, so the input can be reproduced
+                const auto precision = os.precision(std::numeric_limits<InputT>::max_digits10);
+                os << "  Failing input: " << +f.input << " (0x" << std::hex << uint64_t(fuzzBits(f.input)) << std::dec << "), result " << f.value << ", reference " << f.reference << std::endl;
+                os.precision(precision);
+            }
+        }
+    }
+    if constexpr (std::is_floating_point<InputT>::value)
+    {
+        if (r.validityThreshold > 0)
+        {
+            os << "Valid range (relative error <= " << r.validityThreshold << "): ";
+            if (r.hasValidRange)
+            {
+                os << "[" << r.validRange.first << ", " << r.validRange.second << "]" << std::endl;
+            }
+            else
+            {
+                os << "none" << std::endl;
+            }
+        }
+    }
     return os;
 }
 
@@ -196,7 +1182,6 @@ std::ostream& operator<<(std::ostream& os, const std::vector<Result<InputT, Stor
     os << "Input range: ";
     os << "(" << fr.inputRange.first << ", " << fr.inputRange.second << "), ";
     os << fr.samplesInRange << " samples in range" << std::endl;
-    os << "Approximate loop and call overhead (already subtracted): " << float(fr.overheadNs) / float(fr.samplesInRange) << " ns / call" << std::endl;
     os << "Tested functions:" << std::endl
        << std::endl;
     for (const auto& r : rs)
@@ -0,0 +1,363 @@
+#pragma once
+
+// Activation functions for neural networks: Hyperbolic tangent, logistic sigmoid and error function of float values.
+// The kernels are written as templates using the building blocks from floatops.h, so every one has a scalar and an AVX2 batch version.
+// See: https://en.wikipedia.org/wiki/Activation_function
+// See: Eigen, generic_fast_tanh_float / generic_fast_erf_float: https://gitlab.com/libeigen/eigen/-/blob/master/Eigen/src/Core/MathFunctionsImpl.h
+// See: Abramowitz and Stegun, "Handbook of Mathematical Functions", 7.1.26 and 7.1.27
+// License: Eigen is MPL2 (See: https://www.mozilla.org/en-US/MPL/2.0/)
+
+// All functions here work for all finite input values. Inputs are clamped to where the result saturates in float precision.
+
+#include "floatops.h"
+#include "test.h"
+#include "test_exp2f.h"
+#include <cmath>
+#include <vector>
+
+// Odd 13th degree polynomial approximating tanh(x) in [-3.5, 3.5] (max. absolute error ~1.9e-3 incl. clamping)
+static const Coefficients<7> TanhfPoly13 = {0.990517177F, -0.291845502F, 0.076493587F, -0.0130510055F, 0.00131429692F, -7.03163254e-05F, 1.53392543e-06F};
+// Numerator and denominator of the 13/6 rational minimax approximation of tanh(x) from Eigen
+static const Coefficients<7> TanhfRationalP = {4.89352455891786e-03F, 6.37261928875436e-04F, 1.48572235717979e-05F, 5.12229709037114e-08F, -8.60467152213735e-11F, 2.00018790482477e-13F, -2.76076847742355e-16F};
+static const Coefficients<4> TanhfRationalQ = {4.89352518554385e-03F, 2.26843463243900e-03F, 1.18534705686654e-04F, 1.19825839466702e-06F};
+// Numerator and denominator of the rational approximation of erf(x) from Eigen
+static const Coefficients<7> ErffRationalP = {-1.60960333262415e-02F, -2.95459980854025e-03F, -7.34990630326855e-04F, -5.69250639462346e-05F, -2.10102402082508e-06F, 2.77068142495902e-08F, -2.72614225801306e-10F};
+static const Coefficients<5> ErffRationalQ = {-1.42647390514189e-02F, -7.37332916720468e-03F, -1.68282697438203e-03F, -2.13374055278905e-04F, -1.45660718464996e-05F};
+// Abramowitz and Stegun 7.1.26 (max. error 1.5e-7)
+static const Coefficients<5> ErffAS26 = {0.254829592F, -0.284496736F, 1.421413741F, -1.453152027F, 1.061405429F};
+// Abramowitz and Stegun 7.1.27 (max. error 5e-4)
+static const Coefficients<4> ErffAS27 = {0.278393F, 0.230389F, 0.000972F, 0.078108F};
+
+// Calculate the reference values for comparison.
+long double tanhf_reference(const long double x)
+{
+    return tanhl(x);
+}
+
+long double sigmoidf_reference(const long double x)
+{
+    return 1.0L / (1.0L + expl(-x));
+}
+
+long double erff_reference(const long double x)
+{
+    return erfl(x);
+}
+
+// ----- tanh -----
+
+// Padé approximant x * (27 + x^2) / (27 + 9 * x^2), which is exactly 1 at x = 3 (max. absolute error ~0.02)
+template <typename V>
+inline V tanhf_pade(const V x)
+{
+    const V c = clamp(x, -3.0F, 3.0F);
+    const V c2 = multiply(c, c);
+    return divide(multiply(c, add(c2, broadcast<V>(27.0F))), multiplyAdd(c2, broadcast<V>(9.0F), broadcast<V>(27.0F)));
+}
+
+// Clamp + odd polynomial
+template <typename V>
+inline V tanhf_poly(const V x)
+{
+    const V c = clamp(x, -3.5F, 3.5F);
+    return multiply(c, evaluatePolynomial(multiply(c, c), TanhfPoly13));
+}
+
+// Clamp + rational minimax approximation. tanh(x) rounds to 1 in float for |x| > ~7.9
+template <typename V>
+inline V tanhf_rational(const V x)
+{
+    const V c = clamp(x, -7.90531110763549805F, 7.90531110763549805F);
+    const V c2 = multiply(c, c);
+    return divide(multiply(c, evaluatePolynomial(c2, TanhfRationalP)), evaluatePolynomial(c2, TanhfRationalQ));
+}
+
+// tanh(x) = 1 - 2 / (e^(2x) + 1) using the exp2 polynomial from test_exp2f.h.
+// Loses relative precision close to 0 due to cancellation.
+template <typename V>
+inline V tanhf_exp2(const V x)
+{
+    const V e = exp2f_poly4(multiply(clamp(x, -9.0F, 9.0F), broadcast<V>(2.0F * LOG2E_F)));
+    return subtract(broadcast<V>(1.0F), divide(broadcast<V>(2.0F), add(e, broadcast<V>(1.0F))));
+}
+
+// Standard tanh function for comparison.
+float tanhf_0(const float x)
+{
+    return std::tanh(x);
+}
+
+float tanhf_1(const float x)
+{
+    return tanhf_pade(x);
+}
+
+float tanhf_2(const float x)
+{
+    return tanhf_poly(x);
+}
+
+float tanhf_3(const float x)
+{
+    return tanhf_rational(x);
+}
+
+float tanhf_4(const float x)
+{
+    return tanhf_exp2(x);
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+// The same kernels 8 values at a time
+void tanhf_5(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return tanhf_pade(v); });
+}
+
+void tanhf_6(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return tanhf_poly(v); });
+}
+
+void tanhf_7(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return tanhf_rational(v); });
+}
+
+void tanhf_8(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return tanhf_exp2(v); });
+}
+#endif
+
+// ----- sigmoid -----
+
+// "Fast sigmoid" using the softsign function x / (1 + |x|). Has the right shape, but saturates much slower (max. absolute error ~0.08)
+template <typename V>
+inline V sigmoidf_softsign(const V x)
+{
+    const V s = divide(x, add(broadcast<V>(1.0F), absolute(x)));
+    return multiplyAdd(s, broadcast<V>(0.5F), broadcast<V>(0.5F));
+}
+
+// 1 / (1 + e^-x) using the exp2 polynomial from test_exp2f.h. x is clamped so 2^x stays a normal float value
+template <typename V>
+inline V sigmoidf_exp2(const V x)
+{
+    const V e = exp2f_poly4(multiply(clamp(x, -87.0F, 87.0F), broadcast<V>(-LOG2E_F)));
+    return divide(broadcast<V>(1.0F), add(broadcast<V>(1.0F), e));
+}
+
+// sigmoid(x) = 0.5 + 0.5 * tanh(x / 2). Loses relative precision for large negative x due to cancellation
+template <typename V>
+inline V sigmoidf_tanh(const V x)
+{
+    return multiplyAdd(tanhf_rational(multiply(x, broadcast<V>(0.5F))), broadcast<V>(0.5F), broadcast<V>(0.5F));
+}
+
+// Standard exp function for comparison.
+float sigmoidf_0(const float x)
+{
+    return 1.0F / (1.0F + std::exp(-x));
+}
+
+float sigmoidf_1(const float x)
+{
+    return sigmoidf_softsign(x);
+}
+
+// 1 / (1 + e^-x) using Schraudolph's exp bit trick from test_exp2f.h
+float sigmoidf_2(const float x)
+{
+    return 1.0F / (1.0F + exp2f_1(std::min(std::max(x, -87.0F), 87.0F) * -LOG2E_F));
+}
+
+float sigmoidf_3(const float x)
+{
+    return sigmoidf_exp2(x);
+}
+
+float sigmoidf_4(const float x)
+{
+    return sigmoidf_tanh(x);
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+// The same kernels 8 values at a time
+void sigmoidf_5(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return sigmoidf_softsign(v); });
+}
+
+void sigmoidf_6(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return sigmoidf_exp2(v); });
+}
+
+void sigmoidf_7(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return sigmoidf_tanh(v); });
+}
+#endif
+
+// ----- erf -----
+
+// Abramowitz and Stegun 7.1.27: erf(x) = 1 - 1 / (1 + a1 * x + a2 * x^2 + a3 * x^3 + a4 * x^4)^4 for x >= 0
+template <typename V>
+inline V erff_as27(const V x)
+{
+    const V a = absolute(x);
+    const V t = multiplyAdd(a, evaluatePolynomial(a, ErffAS27), broadcast<V>(1.0F));
+    const V t2 = multiply(t, t);
+    return copySign(subtract(broadcast<V>(1.0F), divide(broadcast<V>(1.0F), multiply(t2, t2))), x);
+}
+
+// Abramowitz and Stegun 7.1.26: erf(x) = 1 - (a1 * t + a2 * t^2 + ... + a5 * t^5) * e^(-x^2) with t = 1 / (1 + p * x) for x >= 0.
+// e^(-x^2) is calculated using the exp2 polynomial from test_exp2f.h. erf(x) rounds to 1 in float for |x| > ~3.9
+template <typename V>
+inline V erff_as26(const V x)
+{
+    const V a = absolute(clamp(x, -4.0F, 4.0F));
+    const V t = divide(broadcast<V>(1.0F), multiplyAdd(a, broadcast<V>(0.3275911F), broadcast<V>(1.0F)));
+    const V e = exp2f_poly5(multiply(multiply(a, a), broadcast<V>(-LOG2E_F)));
+    return copySign(subtract(broadcast<V>(1.0F), multiply(multiply(t, evaluatePolynomial(t, ErffAS26)), e)), x);
+}
+
+// Clamp + rational approximation
+template <typename V>
+inline V erff_rational(const V x)
+{
+    const V c = clamp(x, -4.0F, 4.0F);
+    const V c2 = multiply(c, c);
+    return divide(multiply(c, evaluatePolynomial(c2, ErffRationalP)), evaluatePolynomial(c2, ErffRationalQ));
+}
+
+// Standard erf function for comparison.
+float erff_0(const float x)
+{
+    return std::erf(x);
+}
+
+float erff_1(const float x)
+{
+    return erff_as27(x);
+}
+
+float erff_2(const float x)
+{
+    return erff_as26(x);
+}
+
+float erff_3(const float x)
+{
+    return erff_rational(x);
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+// The same kernels 8 values at a time
+void erff_4(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return erff_as27(v); });
+}
+
+void erff_5(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return erff_as26(v); });
+}
+
+void erff_6(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return erff_rational(v); });
+}
+#endif
+
+class TanhfTest : public Test<float, float, double>
+{
+  public:
+    TanhfTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "tanh(x)", inputGenerator,
+            inputRange, samplesInRange, &tanhf_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::tanh", &tanhf_0));
+        results.push_back(run("#1", "Clamp + Padé 3/2", &tanhf_1));
+        results.push_back(run("#2", "Clamp + 13th degree polynomial", &tanhf_2));
+        results.push_back(run("#3", "Clamp + rational 13/6 (Eigen)", &tanhf_3));
+        results.push_back(run("#4", "1 - 2 / (exp2 polynomial + 1)", &tanhf_4));
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runBatch("#5", "AVX2 clamp + Padé 3/2", &tanhf_5));
+        results.push_back(runBatch("#6", "AVX2 clamp + 13th degree polynomial", &tanhf_6));
+        results.push_back(runBatch("#7", "AVX2 clamp + rational 13/6 (Eigen)", &tanhf_7));
+        results.push_back(runBatch("#8", "AVX2 1 - 2 / (exp2 polynomial + 1)", &tanhf_8));
+#endif
+        return results;
+    }
+};
+
+class SigmoidfTest : public Test<float, float, double>
+{
+  public:
+    SigmoidfTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "1 / (1 + e^-x)", inputGenerator,
+            inputRange, samplesInRange, &sigmoidf_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "1 / (1 + std::exp(-x))", &sigmoidf_0));
+        results.push_back(run("#1", "Softsign", &sigmoidf_1));
+        results.push_back(run("#2", "Schraudolph exp", &sigmoidf_2));
+        results.push_back(run("#3", "exp2 polynomial", &sigmoidf_3));
+        results.push_back(run("#4", "0.5 + 0.5 * rational tanh(x / 2)", &sigmoidf_4));
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runBatch("#5", "AVX2 softsign", &sigmoidf_5));
+        results.push_back(runBatch("#6", "AVX2 exp2 polynomial", &sigmoidf_6));
+        results.push_back(runBatch("#7", "AVX2 0.5 + 0.5 * rational tanh(x / 2)", &sigmoidf_7));
+#endif
+        return results;
+    }
+};
+
+class ErffTest : public Test<float, float, double>
+{
+  public:
+    ErffTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "erf(x)", inputGenerator,
+            inputRange, samplesInRange, &erff_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::erf", &erff_0));
+        results.push_back(run("#1", "Abramowitz / Stegun 7.1.27", &erff_1));
+        results.push_back(run("#2", "Abramowitz / Stegun 7.1.26 + exp2 polynomial", &erff_2));
+        results.push_back(run("#3", "Clamp + rational (Eigen)", &erff_3));
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runBatch("#4", "AVX2 Abramowitz / Stegun 7.1.27", &erff_4));
+        results.push_back(runBatch("#5", "AVX2 Abramowitz / Stegun 7.1.26 + exp2 polynomial", &erff_5));
+        results.push_back(runBatch("#6", "AVX2 clamp + rational (Eigen)", &erff_6));
+#endif
+        return results;
+    }
+};
@@ -41,7 +41,7 @@ class Atan2fTest : public Test<std::tuple<float, float>, float, double>
     Atan2fTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
         : Test(
             "atan2(y,x)", inputGenerator,
-            fixupInputRange(inputRange), samplesInRange, &atan2_reference, &dummyFunc)
+            fixupInputRange(inputRange), samplesInRange, &atan2_reference)
     {
     }
 
@@ -54,11 +54,6 @@ class Atan2fTest : public Test<std::tuple<float, float>, float, double>
     }
 
   protected:
-    static float dummyFunc(const input_t x)
-    {
-        return std::get<0>(x);
-    }
-
     static input_range_t fixupInputRange(const input_range_t& range)
     {
         auto yA = std::get<0>(range.first);
@@ -0,0 +1,132 @@
+#pragma once
+
+// Four-quadrant arc tangent of Q1.15 fixed-point (or plain int16_t) coordinates.
+// The result is an angle in [-pi, pi] returned in Q3.12 format.
+// See: "Jack W. Crenshaw - Math Toolkit for Real-Time Development", chapter 7
+// See: https://en.wikipedia.org/wiki/CORDIC
+// See: S. Rajan, S. Wang, R. Inkol, A. Joyal, "Efficient approximations for the arctangent function", IEEE Signal Processing Magazine, May 2006
+
+// Only the ratio of y and x matters, so the inputs can be in any Q format, as long as both use the same.
+// Outputs are raw Q3.12 values, so absolute errors are in LSBs (1 / 4096).
+
+#include "test.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
+// == pi in Q.20
+#define PI_Q20 3294199
+// == pi in Q.15
+#define PI_Q15 102944
+// == pi / 2 in Q.15
+#define PI_2_Q15 51472
+// == pi / 4 in Q.15
+#define PI_4_Q15 25736
+
+// Calculate the reference value for comparison in LSBs.
+long double atan2q15_reference(const std::tuple<long double, long double> yx)
+{
+    return atan2l(std::get<0>(yx), std::get<1>(yx)) * 4096.0L;
+}
+
+// Convert to float, call atan2f and convert back with rounding.
+int16_t atan2q15_0(const std::tuple<int16_t, int16_t> yx)
+{
+    return static_cast<int16_t>(lrintf(atan2f(std::get<0>(yx), std::get<1>(yx)) * 4096.0F));
+}
+
+// CORDIC in vectoring mode. Rotate (x, y) onto the x axis by +-atan(2^-i) and sum up the angles.
+// The vector is pre-rotated by pi if it points into the left half-plane, because CORDIC only converges for angles in (-pi/2, pi/2).
+int16_t atan2q15_1(const std::tuple<int16_t, int16_t> yx)
+{
+    // atan(2^-i) for i in [0, 15] in Q.20
+    static const int32_t AtanTable[16] = {
+        823550, 486170, 256879, 130396, 65451, 32757, 16383, 8192, 4096, 2048, 1024, 512, 256, 128, 64, 32};
+    // scale up to get more precision in the shifts. the CORDIC gain of ~1.647 still fits into 32 bits
+    int32_t y = static_cast<int32_t>(std::get<0>(yx)) << 14;
+    int32_t x = static_cast<int32_t>(std::get<1>(yx)) << 14;
+    int32_t z = 0;
+    if (x == 0 && y == 0)
+    {
+        return 0;
+    }
+    if (x < 0)
+    {
+        z = y >= 0 ? PI_Q20 : -PI_Q20;
+        x = -x;
+        y = -y;
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        const int32_t xi = x;
+        if (y > 0)
+        {
+            x += y >> i;
+            y -= xi >> i;
+            z += AtanTable[i];
+        }
+        else
+        {
+            x -= y >> i;
+            y += xi >> i;
+            z -= AtanTable[i];
+        }
+    }
+    return static_cast<int16_t>((z + (1 << 7)) >> 8);
+}
+
+// Reduce to the first octant, so z = min(|x|, |y|) / max(|x|, |y|) is in [0, 1], and approximate
+// atan(z) = pi/4 * z + z * (1 - z) * (0.2447 + 0.0663 * z). Max. error is ~0.0015 rad.
+int16_t atan2q15_2(const std::tuple<int16_t, int16_t> yx)
+{
+    const int32_t y = std::get<0>(yx);
+    const int32_t x = std::get<1>(yx);
+    const int32_t ay = std::abs(y);
+    const int32_t ax = std::abs(x);
+    if (ax == 0 && ay == 0)
+    {
+        return 0;
+    }
+    const bool swap = ay > ax;
+    const int32_t z = swap ? (ax << 15) / ay : (ay << 15) / ax; // Q0.15
+    int32_t a = (z * (PI_4_Q15 + (((32768 - z) * (8018 + ((2173 * z) >> 15))) >> 15))) >> 15;
+    a = swap ? PI_2_Q15 - a : a;
+    a = x < 0 ? PI_Q15 - a : a;
+    a = y < 0 ? -a : a;
+    return static_cast<int16_t>((a + (1 << 2)) >> 3);
+}
+
+class Atan2Q15Test : public Test<std::tuple<int16_t, int16_t>, int16_t, double>
+{
+  public:
+    Atan2Q15Test(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "atan2(y,x) Q1.15", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &atan2q15_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "float + std::atan2f", &atan2q15_0));
+        results.push_back(run("#1", "CORDIC 16 iterations", &atan2q15_1));
+        results.push_back(run("#2", "Octants + Rajan polynomial", &atan2q15_2));
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        // -32768 can not be negated in 16 bit
+        auto clamp = [](int16_t v) -> int16_t
+        { return v < -32767 ? -32767 : v; };
+        auto yA = clamp(std::get<0>(range.first));
+        auto yB = clamp(std::get<0>(range.second));
+        auto xA = clamp(std::get<1>(range.first));
+        auto xB = clamp(std::get<1>(range.second));
+        return {{std::min(yA, yB), std::min(xA, xB)}, {std::max(yA, yB), std::max(xA, xB)}};
+    }
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+// Cube root of float values, e.g. for color space conversion (CIE Lab).
+// The approximations get an initial guess by dividing the exponent by 3 using the float bit pattern,
+// like sqrtf_5 / sqrtf_6 do for the square root, then refine it using Newton's or Halley's method.
+// See: https://en.wikipedia.org/wiki/Cube_root#Numerical_methods
+// See: fdlibm s_cbrtf.c: https://www.netlib.org/fdlibm/
+// See: http://www.hackersdelight.org/hdcodetxt/acbrt.c.txt
+
+// All functions here assume positive input values.
+
+#include "test.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// Calculate the reference value for comparison.
+long double cbrtf_reference(const long double x)
+{
+    return cbrtl(x);
+}
+
+// Standard cbrtf function for comparison.
+float cbrtf_0(const float x)
+{
+    return std::cbrt(x);
+}
+
+// Dividing the bit pattern by 3 divides the exponent by 3 and adding a magic constant restores the bias.
+// The constant 709958130 from fdlibm balances the relative error of the guess (max. ~3.2%).
+inline float cbrtf_magic(const float x)
+{
+    uint32_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    i = i / 3 + 709958130;
+    float y;
+    std::memcpy(&y, &i, sizeof(y));
+    return y;
+}
+
+// Newton's method for y^3 - x = 0: y = (2 * y + x / y^2) / 3
+inline float cbrtf_newton(const float x, const float y)
+{
+    return (2.0F * y + x / (y * y)) * (1.0F / 3.0F);
+}
+
+// Halley's method for y^3 - x = 0: y = y * (y^3 + 2 * x) / (2 * y^3 + x).
+// Triples the number of correct bits, but needs a division.
+// y^3 and x are both scaled by 8 (y by 2), because y^3 < FLT_MIN for x close to FLT_MIN if the guess is too small,
+// and is flushed to zero with -ffast-math. The scaling is exact, but 8 * x overflows for x > ~4.2e37.
+inline float cbrtf_halley(const float x, const float y)
+{
+    const float y2 = 2.0F * y;
+    const float y3 = y2 * y2 * y2;
+    const float x8 = 8.0F * x;
+    return y * ((y3 + 2.0F * x8) / (2.0F * y3 + x8));
+}
+
+float cbrtf_1(const float x)
+{
+    return cbrtf_magic(x);
+}
+
+// Max. relative error ~1e-3
+float cbrtf_2(const float x)
+{
+    return cbrtf_newton(x, cbrtf_magic(x));
+}
+
+// Max. relative error ~1.7e-6
+float cbrtf_3(const float x)
+{
+    return cbrtf_newton(x, cbrtf_newton(x, cbrtf_magic(x)));
+}
+
+// Max. relative error ~2.1e-5
+float cbrtf_4(const float x)
+{
+    return cbrtf_halley(x, cbrtf_magic(x));
+}
+
+// Max. relative error ~2.2e-7
+float cbrtf_5(const float x)
+{
+    return cbrtf_halley(x, cbrtf_halley(x, cbrtf_magic(x)));
+}
+
+// Guess the inverse cube root y = x^(-1/3) by subtracting a third of the bit pattern from a magic constant
+// and refine it using Newton's method y = y * (4 - x * y^3) / 3, which needs no division. Then cbrt(x) = x * y^2.
+// Max. relative error ~2.2e-5.
+float cbrtf_6(const float x)
+{
+    uint32_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    i = 0x54A21D2A - i / 3;
+    float y;
+    std::memcpy(&y, &i, sizeof(y));
+    y = y * (4.0F - x * y * y * y) * (1.0F / 3.0F);
+    y = y * (4.0F - x * y * y * y) * (1.0F / 3.0F);
+    return x * y * y;
+}
+
+class CbrtfTest : public Test<float, float, double>
+{
+  public:
+    CbrtfTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "cbrtf", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &cbrtf_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::cbrtf", &cbrtf_0));
+        results.push_back(run("#1", "Magic constant", &cbrtf_1));
+        results.push_back(run("#2", "Magic constant + Newton", &cbrtf_2));
+        results.push_back(run("#3", "Magic constant + 2x Newton", &cbrtf_3));
+        results.push_back(run("#4", "Magic constant + Halley", &cbrtf_4));
+        results.push_back(run("#5", "Magic constant + 2x Halley", &cbrtf_5));
+        results.push_back(run("#6", "Inverse magic constant + 2x Newton, no division", &cbrtf_6));
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        input_range_t result;
+        result.first = range.first <= 0 ? std::numeric_limits<input_t>::min() : range.first;
+        result.second = range.second <= 0 ? std::numeric_limits<input_t>::min() : range.second;
+        result.first = result.first > std::numeric_limits<input_t>::max() ? std::numeric_limits<input_t>::max() : result.first;
+        result.second = result.second > std::numeric_limits<input_t>::max() ? std::numeric_limits<input_t>::max() : result.second;
+        return result;
+    }
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+// Binary exponential 2^x of float values.
+// The polynomial kernels use the building blocks from floatops.h. The coefficients are minimax fits
+// of the relative error of 2^f for f in [-0.5, 0.5], with the constant term fixed to 1 so 2^0 == 1.
+// See: https://en.wikipedia.org/wiki/Exponential_function#Computation
+// See: Nicol N. Schraudolph, "A Fast, Compact Approximation of the Exponential Function", Neural Computation 11(4), 1999
+
+// All functions here assume input values in the range [-126, 128), so the result is a normal float value.
+
+#include "floatops.h"
+#include "test.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Max. relative error ~1e-4
+static const Coefficients<3> Exp2fPoly3 = {0.693282933F, 0.242210968F, 0.0550089031F};
+// Max. relative error ~2.8e-6
+static const Coefficients<4> Exp2fPoly4 = {0.693124193F, 0.240240987F, 0.0559064282F, 0.00958285068F};
+// Max. relative error ~9e-8 (~1.5e-7 incl. float rounding)
+static const Coefficients<5> Exp2fPoly5 = {0.693146978F, 0.240222421F, 0.0555073375F, 0.00967151287F, 0.00132647239F};
+
+// Calculate the reference value for comparison.
+long double exp2f_reference(const long double x)
+{
+    return exp2l(x);
+}
+
+// Standard exp2f function for comparison.
+float exp2f_0(const float x)
+{
+    return std::exp2(x);
+}
+
+// Schraudolph: Scale x so that its integer part lands in the exponent bits and the fractional part in the mantissa.
+// The linear mantissa is corrected by a constant to balance the relative error (max. ~6%).
+float exp2f_1(const float x)
+{
+    const uint32_t i = static_cast<uint32_t>(static_cast<int32_t>(x * (1 << 23) + (127.0F - 0.0579F) * (1 << 23)));
+    float y;
+    std::memcpy(&y, &i, sizeof(y));
+    return y;
+}
+
+template <typename V>
+inline V exp2f_poly3(const V x)
+{
+    return exp2Polynomial(x, Exp2fPoly3);
+}
+
+template <typename V>
+inline V exp2f_poly4(const V x)
+{
+    return exp2Polynomial(x, Exp2fPoly4);
+}
+
+template <typename V>
+inline V exp2f_poly5(const V x)
+{
+    return exp2Polynomial(x, Exp2fPoly5);
+}
+
+float exp2f_2(const float x)
+{
+    return exp2f_poly3(x);
+}
+
+float exp2f_3(const float x)
+{
+    return exp2f_poly4(x);
+}
+
+float exp2f_4(const float x)
+{
+    return exp2f_poly5(x);
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+// The same kernels 8 values at a time
+void exp2f_5(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return exp2f_poly3(v); });
+}
+
+void exp2f_6(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return exp2f_poly4(v); });
+}
+
+void exp2f_7(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return exp2f_poly5(v); });
+}
+#endif
+
+class Exp2fTest : public Test<float, float, double>
+{
+  public:
+    Exp2fTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "2^x", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &exp2f_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::exp2f", &exp2f_0));
+        results.push_back(run("#1", "Schraudolph", &exp2f_1));
+        results.push_back(run("#2", "Exponent + 3rd degree polynomial", &exp2f_2));
+        results.push_back(run("#3", "Exponent + 4th degree polynomial", &exp2f_3));
+        results.push_back(run("#4", "Exponent + 5th degree polynomial", &exp2f_4));
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runBatch("#5", "AVX2 exponent + 3rd degree polynomial", &exp2f_5));
+        results.push_back(runBatch("#6", "AVX2 exponent + 4th degree polynomial", &exp2f_6));
+        results.push_back(runBatch("#7", "AVX2 exponent + 5th degree polynomial", &exp2f_7));
+#endif
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        // 2^n must be a normal float value, see splitInteger()
+        input_range_t result;
+        result.first = std::max(-126.0F, std::min(range.first, 127.49F));
+        result.second = std::max(-126.0F, std::min(range.second, 127.49F));
+        return result;
+    }
+};
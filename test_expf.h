@@ -73,7 +73,7 @@ class ExpfTest : public Test<float, float, double>
     ExpfTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
         : Test(
             "e^x", inputGenerator,
-            fixupInputRange(inputRange), samplesInRange, &expf_reference, &dummyFunc)
+            fixupInputRange(inputRange), samplesInRange, &expf_reference)
     {
     }
 
@@ -86,11 +86,6 @@ class ExpfTest : public Test<float, float, double>
     }
 
   protected:
-    static input_t dummyFunc(const input_t x)
-    {
-        return x;
-    }
-
     static input_range_t fixupInputRange(const input_range_t& range)
     {
         input_range_t result;
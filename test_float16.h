@@ -0,0 +1,237 @@
+#pragma once
+
+// Inverse square root, exp and natural logarithm for 16-bit floating-point numbers (fp16 and bf16).
+// The bit manipulation kernels adapt the tricks from test_invsqrtf.h and test_expf.h to the 16-bit formats.
+// See: https://en.wikipedia.org/wiki/Fast_inverse_square_root
+// See: Nicol N. Schraudolph, "A Fast, Compact Approximation of the Exponential Function", Neural Computation 11(4), 1999
+// See: John N. Mitchell, "Computer Multiplication and Division Using Binary Logarithms", IRE Transactions on Electronic Computers, 1962
+
+// All bit manipulation functions here only work for normal input and output values.
+// Values are converted to float for arithmetic, which is what the hardware does too if there is no native 16-bit ALU.
+
+#include "float16.h"
+#include "floatops.h"
+#include "test.h"
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Calculate the reference values for comparison.
+long double invsqrth_reference(const long double x)
+{
+    return 1.0L / sqrtl(x);
+}
+
+long double exph_reference(const long double x)
+{
+    return expl(x);
+}
+
+long double logh_reference(const long double x)
+{
+    return logl(x);
+}
+
+// Convert to float and use the standard function.
+template <typename T>
+T invsqrth_0(const T x)
+{
+    return T(1.0F / std::sqrt(static_cast<float>(x)));
+}
+
+// Subtract half of the bit pattern from a magic constant, like invsqrtf_1 does.
+// The constants are chosen to minimize the maximum relative error after one Newton step (~0.18%).
+template <typename T>
+uint16_t invsqrth_magic(const T x)
+{
+    constexpr uint16_t Magic = Float16Traits<T>::MantissaBits == 10 ? 0x59BA : 0x5F37;
+    return static_cast<uint16_t>(Magic - (toBits(x) >> 1));
+}
+
+template <typename T>
+T invsqrth_1(const T x)
+{
+    return fromBits<T>(invsqrth_magic(x));
+}
+
+// Magic constant + one Newton step in float.
+// y / 2 is made by decrementing the exponent bits of y. With -ffast-math the compiler would otherwise multiply x by 0.5
+// first, which flushes the values in the lowest binade to zero and leaves the error of 1.5 * y there.
+// Note that the compiler can still reorder the multiplications so y * y / 2 underflows for bf16 values > ~1e37.
+template <typename T>
+T invsqrth_2(const T x)
+{
+    const uint16_t bits = invsqrth_magic(x);
+    const float y = static_cast<float>(fromBits<T>(bits));
+    const float halfY = static_cast<float>(fromBits<T>(static_cast<uint16_t>(bits - (1 << Float16Traits<T>::MantissaBits))));
+    return T(y * (1.5F - static_cast<float>(x) * y * halfY));
+}
+
+// Convert to float and use the standard function.
+template <typename T>
+T exph_0(const T x)
+{
+    return T(std::exp(static_cast<float>(x)));
+}
+
+// Schraudolph: Scale x so that its integer part lands in the exponent bits and the fractional part in the mantissa.
+// The linear mantissa is corrected by a constant to balance the relative error (max. ~6%).
+template <typename T>
+T exph_1(const T x)
+{
+    constexpr int MantissaBits = Float16Traits<T>::MantissaBits;
+    constexpr float Scale = static_cast<float>(1 << MantissaBits) * LOG2E_F;
+    constexpr float Offset = static_cast<float>(Float16Traits<T>::ExponentBias << MantissaBits) - 0.0579F * static_cast<float>(1 << MantissaBits);
+    return fromBits<T>(static_cast<uint16_t>(static_cast<int32_t>(static_cast<float>(x) * Scale + Offset)));
+}
+
+// exp(x) = 2^(x / ln(2)). Split into integer and fractional part, calculate 2^fraction
+// using a polynomial (max. relative error 1.6e-4) and add the integer part to the exponent bits.
+template <typename T>
+T exph_2(const T x)
+{
+    const float t = static_cast<float>(x) * LOG2E_F;
+    const float i = std::floor(t);
+    const float f = t - i;
+    const T p = T(1.0F + f * (0.69503748F + f * (0.22830251F + f * 0.07633082F)));
+    return fromBits<T>(static_cast<uint16_t>(toBits(p) + static_cast<int32_t>(i) * (1 << Float16Traits<T>::MantissaBits)));
+}
+
+// Convert to float and use the standard function.
+template <typename T>
+T logh_0(const T x)
+{
+    return T(std::log(static_cast<float>(x)));
+}
+
+// Mitchell: The bit pattern of a floating-point number is a piecewise linear approximation of log2(x) (see sqrtf_1).
+// A constant shifts the error to be balanced (max. absolute error ~0.03).
+template <typename T>
+T logh_1(const T x)
+{
+    constexpr int MantissaBits = Float16Traits<T>::MantissaBits;
+    constexpr float Scale = LN2_F / static_cast<float>(1 << MantissaBits);
+    constexpr float Offset = static_cast<float>(Float16Traits<T>::ExponentBias << MantissaBits) - 0.0430F * static_cast<float>(1 << MantissaBits);
+    return T((static_cast<float>(toBits(x)) - Offset) * Scale);
+}
+
+// Extract exponent and mantissa from the bit pattern and approximate log2(mantissa)
+// with a 3rd degree polynomial (see log2q15_poly, max. error 8.8e-4).
+template <typename T>
+T logh_2(const T x)
+{
+    constexpr int MantissaBits = Float16Traits<T>::MantissaBits;
+    const uint16_t bits = toBits(x);
+    const int e = (bits >> MantissaBits) - Float16Traits<T>::ExponentBias;
+    const float f = static_cast<float>(bits & ((1 << MantissaBits) - 1)) * (1.0F / static_cast<float>(1 << MantissaBits));
+    const float p = f * (1.42310164F + f * (-0.58452498F + f * 0.16207693F));
+    return T((static_cast<float>(e) + p) * LN2_F);
+}
+
+template <typename T>
+class InvSqrthTestT : public Test<T, T, double>
+{
+  public:
+    using typename Test<T, T, double>::input_t;
+    using typename Test<T, T, double>::input_range_t;
+    using typename Test<T, T, double>::input_generator_t;
+    using typename Test<T, T, double>::storage_t;
+
+    InvSqrthTestT(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test<T, T, double>(
+            std::string("1 / sqrt ") + Float16Traits<T>::Name, inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &invsqrth_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(this->run("#0", "float + 1/std::sqrt", &invsqrth_0<T>));
+        results.push_back(this->run("#1", "Magic constant", &invsqrth_1<T>));
+        results.push_back(this->run("#2", "Magic constant + Newton", &invsqrth_2<T>));
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        // smallest normal value is 2^(1 - bias)
+        const float minNormal = std::ldexp(1.0F, 1 - Float16Traits<T>::ExponentBias);
+        input_range_t result;
+        result.first = static_cast<float>(range.first) < minNormal ? T(minNormal) : range.first;
+        result.second = static_cast<float>(range.second) < minNormal ? T(minNormal) : range.second;
+        return result;
+    }
+};
+
+template <typename T>
+class ExphTestT : public Test<T, T, double>
+{
+  public:
+    using typename Test<T, T, double>::input_t;
+    using typename Test<T, T, double>::input_range_t;
+    using typename Test<T, T, double>::input_generator_t;
+    using typename Test<T, T, double>::storage_t;
+
+    ExphTestT(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test<T, T, double>(
+            std::string("exp ") + Float16Traits<T>::Name, inputGenerator,
+            inputRange, samplesInRange, &exph_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(this->run("#0", "float + std::exp", &exph_0<T>));
+        results.push_back(this->run("#1", "Schraudolph", &exph_1<T>));
+        results.push_back(this->run("#2", "Exponent + polynomial", &exph_2<T>));
+        return results;
+    }
+};
+
+template <typename T>
+class LoghTestT : public Test<T, T, double>
+{
+  public:
+    using typename Test<T, T, double>::input_t;
+    using typename Test<T, T, double>::input_range_t;
+    using typename Test<T, T, double>::input_generator_t;
+    using typename Test<T, T, double>::storage_t;
+
+    LoghTestT(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test<T, T, double>(
+            std::string("log ") + Float16Traits<T>::Name, inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &logh_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(this->run("#0", "float + std::log", &logh_0<T>));
+        results.push_back(this->run("#1", "Mitchell", &logh_1<T>));
+        results.push_back(this->run("#2", "Exponent + polynomial", &logh_2<T>));
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        // smallest normal value is 2^(1 - bias)
+        const float minNormal = std::ldexp(1.0F, 1 - Float16Traits<T>::ExponentBias);
+        input_range_t result;
+        result.first = static_cast<float>(range.first) < minNormal ? T(minNormal) : range.first;
+        result.second = static_cast<float>(range.second) < minNormal ? T(minNormal) : range.second;
+        return result;
+    }
+};
+
+using InvSqrthTest = InvSqrthTestT<half_t>;
+using InvSqrtbf16Test = InvSqrthTestT<bfloat16>;
+using ExphTest = ExphTestT<half_t>;
+using Expbf16Test = ExphTestT<bfloat16>;
+using LoghTest = LoghTestT<half_t>;
+using Logbf16Test = LoghTestT<bfloat16>;
@@ -73,7 +73,7 @@ class InvSqrtfTest : public Test<float, float, double>
     InvSqrtfTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
         : Test(
             "1 / sqrtf", inputGenerator,
-            fixupInputRange(inputRange), samplesInRange, &invsqrtf_reference, &dummyFunc)
+            fixupInputRange(inputRange), samplesInRange, &invsqrtf_reference)
     {
     }
 
@@ -87,11 +87,6 @@ class InvSqrtfTest : public Test<float, float, double>
     }
 
   protected:
-    static input_t dummyFunc(const input_t x)
-    {
-        return x;
-    }
-
     static input_range_t fixupInputRange(const input_range_t& range)
     {
         input_range_t result;
@@ -0,0 +1,97 @@
+#pragma once
+
+// Inverse square root of signed Q16.16 fixed-point numbers.
+// See: "Jack W. Crenshaw - Math Toolkit for Real-Time Development", chapter 4
+// See: https://en.wikipedia.org/wiki/Fast_inverse_square_root
+
+// All functions here assume positive, non-zero input values.
+// Inputs and outputs are raw Q16.16 values, so absolute errors are in LSBs (1 / 65536).
+
+#include "bitops.h"
+#include "test.h"
+#include "test_invsqrtf.h"
+#include "test_sqrti.h"
+#include <cstdint>
+#include <math.h>
+#include <vector>
+
+// Calculate the reference value for comparison in LSBs.
+// 1 / sqrt(x / 2^16) * 2^16 == 2^24 / sqrt(x)
+long double invsqrtq16_reference(const long double x)
+{
+    return 16777216.0L / sqrtl(x);
+}
+
+// Convert to float, call 1 / sqrtf and convert back with rounding.
+int32_t invsqrtq16_0(const int32_t x)
+{
+    return static_cast<int32_t>(65536.0F / sqrtf(x * (1.0F / 65536.0F)) + 0.5F);
+}
+
+// Convert to float, use "Quake 3 fast inverse square root" with two Newton iterations (invsqrtf_2) and convert back.
+int32_t invsqrtq16_1(const int32_t x)
+{
+    return static_cast<int32_t>(invsqrtf_2(x * (1.0F / 65536.0F)) * 65536.0F + 0.5F);
+}
+
+// Integer square root + division: 2^24 / sqrt(x) == 2^40 / sqrt(x * 2^32).
+// The isqrt result is truncated, so the error grows for small values.
+int32_t invsqrtq16_2(const int32_t x)
+{
+    const uint64_t s = sqrti_6<uint64_t>(static_cast<uint64_t>(x) << 32);
+    return static_cast<int32_t>(((uint64_t(1) << 40) + s / 2) / s);
+}
+
+// Normalize x to m in [0.25, 1) using count leading zeros, get an initial guess for 1 / sqrt(m)
+// from a 48 entry table and apply two Newton iterations y = y * (3 - m * y^2) / 2 in Q2.30.
+// The result is then scaled back by the square root of the normalization factor.
+int32_t invsqrtq16_3(const int32_t x)
+{
+    // 1 / sqrt((i + 0.5) / 64) for i in [16, 63] in Q2.30
+    static const uint32_t InvSqrtTable[48] = {
+        0x7E0BB221, 0x7A64336B, 0x77099EFB, 0x73F1F68D, 0x7114F644, 0x6E6BB6E9, 0x6BF06762, 0x699E16D0,
+        0x67708AF9, 0x65641FAE, 0x6375AD16, 0x61A27320, 0x5FE808FC, 0x5E444FAF, 0x5CB56711, 0x5B39A4C7,
+        0x59CF8CBC, 0x5875CADE, 0x572B2DE0, 0x55EEA2C4, 0x54BF311A, 0x539BF7CD, 0x52842A5F, 0x51770E8F,
+        0x5073FA50, 0x4F7A5202, 0x4E8986EA, 0x4DA115DA, 0x4CC08605, 0x4BE767F5, 0x4B1554A6, 0x4A49ECB3,
+        0x4984D7A4, 0x48C5C34B, 0x480C6332, 0x4758701C, 0x46A9A794, 0x45FFCB80, 0x455AA1CB, 0x44B9F40B,
+        0x441D8F3B, 0x43854374, 0x42F0E3AE, 0x4260458E, 0x41D3412A, 0x4149B0E5, 0x40C3713B, 0x404060A1};
+    // shift by an even number of bits, so the square root of the shift is an integer
+    const int s = countLeadingZeros(static_cast<uint32_t>(x)) & ~1;
+    const uint64_t m = static_cast<uint32_t>(x) << s; // Q0.32 in [0.25, 1)
+    uint64_t y = InvSqrtTable[(m >> 26) - 16]; // Q2.30
+    y = (y * ((uint64_t(3) << 30) - ((m * ((y * y) >> 30)) >> 32))) >> 31;
+    y = (y * ((uint64_t(3) << 30) - ((m * ((y * y) >> 30)) >> 32))) >> 31;
+    // 1 / sqrt(x) == 1 / sqrt(m) * 2^(s / 2 - 8). Q2.30 to Q16.16 is another shift by 14
+    const int shift = 22 - s / 2;
+    return static_cast<int32_t>((y + (uint64_t(1) << (shift - 1))) >> shift);
+}
+
+class InvSqrtQ16Test : public Test<int32_t, int32_t, double>
+{
+  public:
+    InvSqrtQ16Test(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "1 / sqrt Q16.16", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &invsqrtq16_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "float + 1/std::sqrtf", &invsqrtq16_0));
+        results.push_back(run("#1", "float + Quake3 + 2x Newton", &invsqrtq16_1));
+        results.push_back(run("#2", "64 bit isqrt + division", &invsqrtq16_2));
+        results.push_back(run("#3", "clz + table + 2x Newton", &invsqrtq16_3));
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        input_range_t result;
+        result.first = range.first < 1 ? 1 : range.first;
+        result.second = range.second < 1 ? 1 : range.second;
+        return result;
+    }
+};
@@ -0,0 +1,222 @@
+#pragma once
+
+// The functions in this file are double versions of the functions in test_log10f.h.
+// See there for sources.
+// All functions here assume positive, non-zero input values.
+// All functions operate on double values.
+
+#include "test.h"
+#include <cstddef>
+#include <cstdint>
+#include <math.h>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#ifdef APPROX_HAVE_QUADMATH
+#include <quadmath.h>
+#endif
+
+// == 1 / log2(10)
+#define ONE_OVER_LOG2_10_D 0.30102999566398119521
+
+// Calculate the reference value for comparison.
+// A long double only has 64 bits of mantissa, so use quad precision if available.
+long double log10d_reference(const long double x)
+{
+#ifdef APPROX_HAVE_QUADMATH
+    return (long double)log10q((__float128)x);
+#else
+    return log10l(x);
+#endif
+}
+
+// Standard log10 function for comparison.
+double log10d_0(const double x)
+{
+    return log10(x);
+}
+
+// log2(x) / log2(10).
+double log10d_1(const double x)
+{
+    return log2(x) * ONE_OVER_LOG2_10_D;
+}
+
+// Get approximation for log2(x).
+// Dr. Paul Beckmann
+// See: http://openaudio.blogspot.com/2017/02/faster-log10-and-pow.html
+// And: https://community.arm.com/developer/tools-software/tools/f/armds-forum/4292/cmsis-dsp-new-functionality-proposal/22621#22621
+double log10d_2(const double x)
+{
+    double Y, F;
+    int E;
+    F = frexp(fabs(x), &E);
+    Y = 1.23149591368684;
+    Y *= F;
+    Y += -4.11852516267426;
+    Y *= F;
+    Y += 6.02197014179219;
+    Y *= F;
+    Y += -3.13396450166353;
+    Y += E;
+    return (Y * ONE_OVER_LOG2_10_D);
+}
+
+// compute log2(x) by reducing x to [0.75, 1.5), then divide by log2(10)
+// David Goldberg
+// See: https://tech.ebayinc.com/engineering/fast-approximate-logarithms-part-iii-the-formulas/
+// This version uses divides
+double log10d_3(double x)
+{
+    const double a = 0.338953;
+    const double b = 2.198599;
+    const double c = 1.523692;
+    union
+    {
+        double f;
+        uint64_t i;
+    } ux1, ux2;
+    // IEEE representation is sgn(1):exp(11):frac(52)
+    ux1.f = x;
+    const int64_t exp = (ux1.i & UINT64_C(0x7FF0000000000000)) >> 52;
+    double signif, fexp;
+    if (ux1.i & UINT64_C(0x0008000000000000)) // true if signif > 1.5
+    {
+        // signif >= 1.5 so need to divide by 2
+        ux2.i = (ux1.i & UINT64_C(0x000FFFFFFFFFFFFF)) | UINT64_C(0x3FE0000000000000);
+        signif = ux2.f - 1.0;
+        fexp = exp - 1022; // 1022 instead of 1023 compensates for division by 2
+    }
+    else
+    {
+        ux2.i = (ux1.i & UINT64_C(0x000FFFFFFFFFFFFF)) | UINT64_C(0x3FF0000000000000);
+        signif = ux2.f - 1.0;
+        fexp = exp - 1023;
+    }
+    const double lg2 = fexp + signif * (a * signif + b) / (signif + c);
+    return lg2 * ONE_OVER_LOG2_10_D;
+}
+
+// compute log2(x) by reducing x to [0.75, 1.5), then divide by log2(10)
+// David Goldberg
+// See: https://tech.ebayinc.com/engineering/fast-approximate-logarithms-part-iii-the-formulas/
+// This version uses only multiplies
+double log10d_4(double x)
+{
+    const double a = 0.338531;
+    const double b = -0.741619;
+    const double c = 1.445866;
+    union
+    {
+        double f;
+        uint64_t i;
+    } ux1, ux2;
+    // IEEE representation is sgn(1):exp(11):frac(52)
+    ux1.f = x;
+    const int64_t exp = (ux1.i & UINT64_C(0x7FF0000000000000)) >> 52;
+    double signif, fexp;
+    if (ux1.i & UINT64_C(0x0008000000000000)) // true if signif > 1.5
+    {
+        // signif >= 1.5 so need to divide by 2
+        ux2.i = (ux1.i & UINT64_C(0x000FFFFFFFFFFFFF)) | UINT64_C(0x3FE0000000000000);
+        signif = ux2.f - 1.0;
+        fexp = exp - 1022; // 1022 instead of 1023 compensates for division by 2
+    }
+    else
+    {
+        ux2.i = (ux1.i & UINT64_C(0x000FFFFFFFFFFFFF)) | UINT64_C(0x3FF0000000000000);
+        signif = ux2.f - 1.0;
+        fexp = exp - 1023;
+    }
+    const double lg2 = fexp + (((a * signif) + b) * signif + c) * signif;
+    return lg2 * ONE_OVER_LOG2_10_D;
+}
+
+// Batch version of the standard log10 function, calling log10 for every value.
+// Lets the compiler auto-vectorize if it has a vector math library.
+void log10d_5(const double* x, double* y, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        y[i] = log10(x[i]);
+    }
+}
+
+#if defined(__AVX2__)
+// Batch version of log10d_4 (David Goldberg mul) using AVX2.
+// The branch on the significand is replaced by selecting the exponent bits with a mask.
+void log10d_6(const double* x, double* y, std::size_t count)
+{
+    const __m256d a = _mm256_set1_pd(0.338531);
+    const __m256d b = _mm256_set1_pd(-0.741619);
+    const __m256d c = _mm256_set1_pd(1.445866);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d oneOverLog2_10 = _mm256_set1_pd(ONE_OVER_LOG2_10_D);
+    const __m256i greaterBit = _mm256_set1_epi64x(INT64_C(0x0008000000000000));
+    const __m256i mantissaMask = _mm256_set1_epi64x(INT64_C(0x000FFFFFFFFFFFFF));
+    const __m256i exponent0 = _mm256_set1_epi64x(INT64_C(0x3FF0000000000000));
+    const __m256i exponentBias = _mm256_set1_epi64x(1023);
+    // adding 2^52 + 2^51 converts small integers to double without cvtepi64_pd, which AVX2 does not have
+    const __m256d intToDouble = _mm256_set1_pd(6755399441055744.0);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i bits = _mm256_castpd_si256(_mm256_loadu_pd(x + i));
+        // all bits set if signif > 1.5
+        const __m256i greater = _mm256_cmpeq_epi64(_mm256_and_si256(bits, greaterBit), greaterBit);
+        // divide signif by 2 if needed by subtracting 1 from the exponent. greater is -1 then
+        const __m256i signifBits = _mm256_or_si256(_mm256_and_si256(bits, mantissaMask), _mm256_add_epi64(exponent0, _mm256_slli_epi64(greater, 52)));
+        const __m256d signif = _mm256_sub_pd(_mm256_castsi256_pd(signifBits), one);
+        const __m256i exp = _mm256_sub_epi64(_mm256_sub_epi64(_mm256_srli_epi64(bits, 52), exponentBias), greater);
+        const __m256d fexp = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(exp, _mm256_castpd_si256(intToDouble))), intToDouble);
+        __m256d lg2 = _mm256_add_pd(_mm256_mul_pd(a, signif), b);
+        lg2 = _mm256_add_pd(_mm256_mul_pd(lg2, signif), c);
+        lg2 = _mm256_add_pd(_mm256_mul_pd(lg2, signif), fexp);
+        _mm256_storeu_pd(y + i, _mm256_mul_pd(lg2, oneOverLog2_10));
+    }
+    for (; i < count; ++i)
+    {
+        y[i] = log10d_4(x[i]);
+    }
+}
+#endif
+
+class Log10dTest : public Test<double, double, long double>
+{
+  public:
+    Log10dTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "log10d", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &log10d_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::log10", &log10d_0));
+        results.push_back(run("#1", "log2(x) / log2(10)", &log10d_1));
+        results.push_back(run("#2", "ARM forum / Dr. Paul Beckmann", &log10d_2));
+        results.push_back(run("#3", "David Goldberg div", &log10d_3));
+        results.push_back(run("#4", "David Goldberg mul", &log10d_4));
+        results.push_back(runBatch("#5", "std::log10 batch", &log10d_5));
+#if defined(__AVX2__)
+        results.push_back(runBatch("#6", "AVX2 David Goldberg mul", &log10d_6));
+#endif
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        input_range_t result;
+        result.first = range.first <= 0 ? std::numeric_limits<input_t>::min() : range.first;
+        result.second = range.second <= 0 ? std::numeric_limits<input_t>::min() : range.second;
+        result.first = result.first > std::numeric_limits<input_t>::max() ? std::numeric_limits<input_t>::max() : result.first;
+        result.second = result.second > std::numeric_limits<input_t>::max() ? std::numeric_limits<input_t>::max() : result.second;
+        return result;
+    }
+};
@@ -5,6 +5,7 @@
 // All functions operate on float values, but some can be used on double values too.
 
 #include "test.h"
+#include "test_log2f.h"
 #include <cstdint>
 #include <math.h>
 #include <vector>
@@ -161,13 +162,28 @@ float log10f_4(float x)
     return lg2 * ONE_OVER_LOG2_10;
 }
 
+// 7th degree log2 polynomial from test_log2f.h, then divide by log2(10).
+float log10f_5(const float x)
+{
+    return log2f_poly7(x) * ONE_OVER_LOG2_10;
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+// The same 8 values at a time
+void log10f_6(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return multiply(log2f_poly7(v), broadcast<decltype(v)>(ONE_OVER_LOG2_10)); });
+}
+#endif
+
 class Log10Test : public Test<float, float, double>
 {
   public:
     Log10Test(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
         : Test(
             "log10f", inputGenerator,
-            fixupInputRange(inputRange), samplesInRange, &log10f_reference, &dummyFunc)
+            fixupInputRange(inputRange), samplesInRange, &log10f_reference)
     {
     }
 
@@ -179,15 +195,14 @@ class Log10Test : public Test<float, float, double>
         results.push_back(run("#2", "ARM forum / Dr. Paul Beckmann", &log10f_2));
         results.push_back(run("#3", "David Goldberg div", &log10f_3));
         results.push_back(run("#4", "David Goldberg mul", &log10f_4));
+        results.push_back(run("#5", "Exponent + 7th degree log2 polynomial", &log10f_5));
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runBatch("#6", "AVX2 exponent + 7th degree log2 polynomial", &log10f_6));
+#endif
         return results;
     }
 
   protected:
-    static input_t dummyFunc(const input_t x)
-    {
-        return x;
-    }
-
     static input_range_t fixupInputRange(const input_range_t& range)
     {
         input_range_t result;
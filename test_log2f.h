@@ -0,0 +1,136 @@
+#pragma once
+
+// Binary logarithm log2(x) of float values.
+// The polynomial kernels use the building blocks from floatops.h. The coefficients are least-squares / minimax fits
+// of log2(1 + f) for f in [sqrt(0.5) - 1, sqrt(2) - 1], with the constant term fixed to 0 so log2(1) == 0.
+// See: https://en.wikipedia.org/wiki/Binary_logarithm
+// See: http://openaudio.blogspot.com/2017/02/faster-log10-and-pow.html
+
+// All functions here assume positive, normal input values.
+
+#include "floatops.h"
+#include "test.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// Max. absolute error ~8.5e-4
+static const Coefficients<3> Log2fPoly3 = {1.44515231F, -0.7540812F, 0.445067292F};
+// Max. absolute error ~1.5e-5
+static const Coefficients<5> Log2fPoly5 = {1.442578F, -0.720241816F, 0.486686462F, -0.394575075F, 0.252658062F};
+// Max. absolute error ~3e-7
+static const Coefficients<7> Log2fPoly7 = {1.44269973F, -0.721375871F, 0.480465014F, -0.358961896F, 0.297262912F, -0.272697527F, 0.170632803F};
+
+// Calculate the reference value for comparison.
+long double log2f_reference(const long double x)
+{
+    return log2l(x);
+}
+
+// Standard log2f function for comparison.
+float log2f_0(const float x)
+{
+    return std::log2(x);
+}
+
+// Mitchell: The bit pattern of a floating-point number is a piecewise linear approximation of log2(x).
+// Max. absolute error ~0.086.
+float log2f_1(const float x)
+{
+    uint32_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    return static_cast<float>(i) * (1.0F / (1 << 23)) - 127.0F;
+}
+
+template <typename V>
+inline V log2f_poly3(const V x)
+{
+    return log2Polynomial(x, Log2fPoly3);
+}
+
+template <typename V>
+inline V log2f_poly5(const V x)
+{
+    return log2Polynomial(x, Log2fPoly5);
+}
+
+template <typename V>
+inline V log2f_poly7(const V x)
+{
+    return log2Polynomial(x, Log2fPoly7);
+}
+
+float log2f_2(const float x)
+{
+    return log2f_poly3(x);
+}
+
+float log2f_3(const float x)
+{
+    return log2f_poly5(x);
+}
+
+float log2f_4(const float x)
+{
+    return log2f_poly7(x);
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+// The same kernels 8 values at a time
+void log2f_5(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return log2f_poly3(v); });
+}
+
+void log2f_6(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return log2f_poly5(v); });
+}
+
+void log2f_7(const float* x, float* y, std::size_t count)
+{
+    transformBatch(x, y, count, [](auto v)
+                   { return log2f_poly7(v); });
+}
+#endif
+
+class Log2fTest : public Test<float, float, double>
+{
+  public:
+    Log2fTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "log2(x)", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &log2f_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::log2f", &log2f_0));
+        results.push_back(run("#1", "Mitchell", &log2f_1));
+        results.push_back(run("#2", "Exponent + 3rd degree polynomial", &log2f_2));
+        results.push_back(run("#3", "Exponent + 5th degree polynomial", &log2f_3));
+        results.push_back(run("#4", "Exponent + 7th degree polynomial", &log2f_4));
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runBatch("#5", "AVX2 exponent + 3rd degree polynomial", &log2f_5));
+        results.push_back(runBatch("#6", "AVX2 exponent + 5th degree polynomial", &log2f_6));
+        results.push_back(runBatch("#7", "AVX2 exponent + 7th degree polynomial", &log2f_7));
+#endif
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        const float minValue = std::numeric_limits<float>::min();
+        input_range_t result;
+        result.first = range.first < minValue ? minValue : range.first;
+        result.second = range.second < minValue ? minValue : range.second;
+        return result;
+    }
+};
@@ -0,0 +1,310 @@
+#pragma once
+
+// Integer binary and decadic logarithm, floor(log2(x)) and floor(log10(x)) of unsigned 32 and 64 bit numbers.
+// See: https://hackaday.com/2023/02/07/count-leading-zeros-for-efficient-logarithms/
+// See: https://graphics.stanford.edu/~seander/bithacks.html#IntegerLogObvious
+// See: https://graphics.stanford.edu/~seander/bithacks.html#IntegerLogDeBruijn
+// See: https://graphics.stanford.edu/~seander/bithacks.html#IntegerLog10
+
+// All functions here assume input values > 0. The result for 0 is undefined.
+
+#include "bitops.h"
+#include "test.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Calculate the exact reference values for comparison.
+// These compare against powers of the base instead of dividing / shifting the input.
+template <typename T>
+int log2i_reference(const T x)
+{
+    int r = 0;
+    while (r + 1 < std::numeric_limits<T>::digits && (T(1) << (r + 1)) <= x)
+    {
+        r++;
+    }
+    return r;
+}
+
+template <typename T>
+int log10i_reference(const T x)
+{
+    int r = 0;
+    for (T p = 1; p <= x / 10; p *= 10)
+    {
+        r++;
+    }
+    return r;
+}
+
+// Naive loop shifting the input right until it is 1.
+template <typename T>
+int log2i_0(T x)
+{
+    int r = 0;
+    while (x >>= 1)
+    {
+        r++;
+    }
+    return r;
+}
+
+// Count leading zeros. Usually a single instruction (lzcnt / bsr / clz).
+template <typename T>
+int log2i_1(const T x)
+{
+    return std::numeric_limits<T>::digits - 1 - countLeadingZeros(x);
+}
+
+// Set all bits below the highest set bit, then use a De Bruijn multiply and a table to find the bit index.
+// Works without count leading zeros, e.g. on older or small CPUs.
+template <typename T>
+int log2i_2(T x)
+{
+    if constexpr (std::numeric_limits<T>::digits <= 32)
+    {
+        static const int DeBruijnTable[32] = {
+            0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+            8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31};
+        uint32_t v = x;
+        v |= v >> 1;
+        v |= v >> 2;
+        v |= v >> 4;
+        v |= v >> 8;
+        v |= v >> 16;
+        return DeBruijnTable[(v * 0x07C4ACDDU) >> 27];
+    }
+    else
+    {
+        static const int DeBruijnTable[64] = {
+            0, 47, 1, 56, 48, 27, 2, 60, 57, 49, 41, 37, 28, 16, 3, 61,
+            54, 58, 35, 52, 50, 42, 21, 44, 38, 32, 29, 23, 17, 11, 4, 62,
+            46, 55, 26, 59, 40, 36, 15, 53, 34, 51, 20, 43, 31, 22, 10, 45,
+            25, 39, 14, 33, 19, 30, 9, 24, 13, 18, 8, 12, 7, 6, 5, 63};
+        uint64_t v = x;
+        v |= v >> 1;
+        v |= v >> 2;
+        v |= v >> 4;
+        v |= v >> 8;
+        v |= v >> 16;
+        v |= v >> 32;
+        return DeBruijnTable[(v * 0x03F79D71B4CB0A89ULL) >> 58];
+    }
+}
+
+// Binary search for the highest set bit using comparisons and shifts, but no branches.
+template <typename T>
+int log2i_3(T x)
+{
+    int r = 0;
+    int s;
+    if constexpr (std::numeric_limits<T>::digits > 32)
+    {
+        s = int(x > 0xFFFFFFFFU) << 5;
+        x >>= s;
+        r |= s;
+    }
+    s = int(x > 0xFFFFU) << 4;
+    x >>= s;
+    r |= s;
+    s = int(x > 0xFFU) << 3;
+    x >>= s;
+    r |= s;
+    s = int(x > 0xFU) << 2;
+    x >>= s;
+    r |= s;
+    s = int(x > 0x3U) << 1;
+    x >>= s;
+    r |= s;
+    return r | int(x >> 1);
+}
+
+// Convert to floating-point and extract the exponent.
+// A 64 bit value could round up to the next power of two when converted to double. Clearing every bit
+// that has a set bit above it keeps the highest bit, but the value is then < 1.5 * 2^n and can not round up.
+template <typename T>
+int log2i_4(const T x)
+{
+    double d;
+    if constexpr (std::numeric_limits<T>::digits > 52)
+    {
+        d = static_cast<double>(x & ~(x >> 1));
+    }
+    else
+    {
+        d = static_cast<double>(x);
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return static_cast<int>(bits >> 52) - 1023;
+}
+
+// Powers of 10 that fit into 64 bits
+static const uint64_t Powers10[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+    10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL};
+
+// Naive loop dividing the input by 10 until it is < 10.
+template <typename T>
+int log10i_0(T x)
+{
+    int r = 0;
+    while (x >= 10)
+    {
+        x /= 10;
+        r++;
+    }
+    return r;
+}
+
+// Loop comparing the input against increasing powers of 10.
+template <typename T>
+int log10i_1(const T x)
+{
+    constexpr int maxLog = std::numeric_limits<T>::digits10;
+    int r = 0;
+    while (r < maxLog && x >= Powers10[r + 1])
+    {
+        r++;
+    }
+    return r;
+}
+
+// log10(x) = log2(x) * log10(2). 1233 / 4096 is slightly bigger than log10(2), so the estimate
+// is off by at most +1, which is corrected by comparing against a table of powers of 10.
+template <typename T>
+int log10i_2(const T x)
+{
+    const int t = ((log2i_1(x) + 1) * 1233) >> 12;
+    return t - int(x < Powers10[t]);
+}
+
+// Same as log10i_2, but using the De Bruijn log2 (log2i_2).
+template <typename T>
+int log10i_3(const T x)
+{
+    const int t = ((log2i_2(x) + 1) * 1233) >> 12;
+    return t - int(x < Powers10[t]);
+}
+
+template <typename T>
+class Log2iTestT : public Test<T, int, double>
+{
+  public:
+    using typename Test<T, int, double>::input_t;
+    using typename Test<T, int, double>::input_range_t;
+    using typename Test<T, int, double>::input_generator_t;
+    using typename Test<T, int, double>::output_t;
+    using typename Test<T, int, double>::storage_t;
+
+    Log2iTestT(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test<T, int, double>(
+            suiteName(), fixupInputGenerator(inputGenerator),
+            fixupInputRange(inputRange), samplesInRange, &log2i_reference<T>)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(this->run("#0", "Shift loop", &log2i_0<T>));
+        results.push_back(this->run("#1", "Count leading zeros", &log2i_1<T>));
+        results.push_back(this->run("#2", "De Bruijn multiply", &log2i_2<T>));
+        results.push_back(this->run("#3", "Branchless binary search", &log2i_3<T>));
+        results.push_back(this->run("#4", "double exponent", &log2i_4<T>));
+        return results;
+    }
+
+  protected:
+    static std::string suiteName()
+    {
+        constexpr int digits = std::numeric_limits<T>::digits;
+        return digits == 32 ? "log2i" : "log2i" + std::to_string(digits);
+    }
+
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        input_range_t result;
+        result.first = range.first < 1 ? 1 : range.first;
+        result.second = range.second < 1 ? 1 : range.second;
+        return result;
+    }
+
+    /// @brief Drop 0, which the "special" and "file" generators return regardless of the range.
+    /// The functions are undefined for 0 and the table lookups can read out of bounds.
+    static input_generator_t fixupInputGenerator(input_generator_t inputGenerator)
+    {
+        return [inputGenerator](const input_range_t& range, uint64_t samplesInRange)
+        {
+            auto values = inputGenerator(range, samplesInRange);
+            values.erase(std::remove(values.begin(), values.end(), T(0)), values.end());
+            return values;
+        };
+    }
+};
+
+template <typename T>
+class Log10iTestT : public Test<T, int, double>
+{
+  public:
+    using typename Test<T, int, double>::input_t;
+    using typename Test<T, int, double>::input_range_t;
+    using typename Test<T, int, double>::input_generator_t;
+    using typename Test<T, int, double>::output_t;
+    using typename Test<T, int, double>::storage_t;
+
+    Log10iTestT(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test<T, int, double>(
+            suiteName(), fixupInputGenerator(inputGenerator),
+            fixupInputRange(inputRange), samplesInRange, &log10i_reference<T>)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(this->run("#0", "Division loop", &log10i_0<T>));
+        results.push_back(this->run("#1", "Power of 10 loop", &log10i_1<T>));
+        results.push_back(this->run("#2", "clz + table correction", &log10i_2<T>));
+        results.push_back(this->run("#3", "De Bruijn + table correction", &log10i_3<T>));
+        return results;
+    }
+
+  protected:
+    static std::string suiteName()
+    {
+        constexpr int digits = std::numeric_limits<T>::digits;
+        return digits == 32 ? "log10i" : "log10i" + std::to_string(digits);
+    }
+
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        input_range_t result;
+        result.first = range.first < 1 ? 1 : range.first;
+        result.second = range.second < 1 ? 1 : range.second;
+        return result;
+    }
+
+    /// @brief Drop 0, which the "special" and "file" generators return regardless of the range.
+    /// The functions are undefined for 0 and the table lookups can read out of bounds.
+    static input_generator_t fixupInputGenerator(input_generator_t inputGenerator)
+    {
+        return [inputGenerator](const input_range_t& range, uint64_t samplesInRange)
+        {
+            auto values = inputGenerator(range, samplesInRange);
+            values.erase(std::remove(values.begin(), values.end(), T(0)), values.end());
+            return values;
+        };
+    }
+};
+
+using Log2iTest = Log2iTestT<uint32_t>;
+using Log2i64Test = Log2iTestT<uint64_t>;
+using Log10iTest = Log10iTestT<uint32_t>;
+using Log10i64Test = Log10iTestT<uint64_t>;
@@ -0,0 +1,194 @@
+#pragma once
+
+// Binary and decadic logarithm of Q1.15 fixed-point numbers.
+// See: Clay S. Turner, "A Fast Binary Logarithm Algorithm", IEEE Signal Processing Magazine, September 2010
+// See: https://hackaday.com/2023/02/07/count-leading-zeros-for-efficient-logarithms/
+
+// All functions here assume positive, non-zero input values, so inputs are in (0, 1).
+// The results are in [-15, 0) and returned in Q4.11 format.
+// Inputs and outputs are raw fixed-point values, so absolute errors are in LSBs (1 / 2048).
+
+#include "bitops.h"
+#include "test.h"
+#include <cstdint>
+#include <math.h>
+#include <vector>
+
+// == log10(2) in Q0.16
+#define LOG10_2_Q16 19728
+
+// Calculate the reference values for comparison in LSBs.
+long double log2q15_reference(const long double x)
+{
+    return log2l(x / 32768.0L) * 2048.0L;
+}
+
+long double log10q15_reference(const long double x)
+{
+    return log10l(x / 32768.0L) * 2048.0L;
+}
+
+// The functions below return log2(x) with 15 fractional bits.
+// The integer part of log2(x) is the position of the highest set bit,
+// so the mantissa always is a value in [1, 2).
+
+// Count leading zeros to get the integer part, then linearly interpolate log2(mantissa) from a 33 entry table.
+int32_t log2q15_lut(const int16_t x)
+{
+    // log2(1 + i / 32) for i in [0, 32] in Q0.15
+    static const int32_t Log2Table[33] = {
+        0, 1455, 2866, 4236, 5568, 6863, 8124, 9352, 10549, 11716, 12855, 13968, 15055, 16117, 17156, 18173,
+        19168, 20143, 21098, 22034, 22952, 23852, 24736, 25604, 26455, 27292, 28114, 28922, 29717, 30498, 31267, 32024,
+        32768};
+    const int n = bitLength(static_cast<uint16_t>(x)) - 1;
+    const int32_t f = (static_cast<int32_t>(x) << (14 - n)) - (1 << 14); // mantissa - 1 in Q0.14
+    const int32_t i = f >> 9;
+    const int32_t t = Log2Table[i] + (((Log2Table[i + 1] - Log2Table[i]) * (f & 0x1FF)) >> 9);
+    return ((n - 15) << 15) + t;
+}
+
+// Count leading zeros to get the integer part, then approximate log2(mantissa) with a 3rd degree polynomial.
+// Coefficients are a least squares fit of log2(1 + f) for f in [0, 1), max. error 8.8e-4.
+int32_t log2q15_poly(const int16_t x)
+{
+    const int n = bitLength(static_cast<uint16_t>(x)) - 1;
+    const int32_t f = (static_cast<int32_t>(x) << (15 - n)) - (1 << 15); // mantissa - 1 in Q0.15
+    int32_t t = 5311; // 0.16207693
+    t = ((t * f) >> 15) - 19154; // -0.58452498
+    t = ((t * f) >> 15) + 46632; // 1.42310164
+    t = (t * f) >> 15;
+    return ((n - 15) << 15) + t;
+}
+
+// Clay S. Turner's algorithm. Square the mantissa once for every fractional bit.
+// If the square is >= 2, the bit is set and the square is divided by 2.
+int32_t log2q15_turner(const int16_t x)
+{
+    const int n = bitLength(static_cast<uint16_t>(x)) - 1;
+    uint64_t z = static_cast<uint64_t>(x) << (30 - n); // mantissa in Q2.30
+    int32_t y = (n - 15) << 15;
+    for (int32_t b = 1 << 14; b > 0; b >>= 1)
+    {
+        z = (z * z) >> 30;
+        if (z >= (uint64_t(2) << 30))
+        {
+            z >>= 1;
+            y += b;
+        }
+    }
+    return y;
+}
+
+// Convert log2 with 15 fractional bits to Q4.11 with rounding.
+int16_t log2q15_to_q11(const int32_t y)
+{
+    return static_cast<int16_t>((y + (1 << 3)) >> 4);
+}
+
+// Convert log2 with 15 fractional bits to log10 in Q4.11 with rounding.
+int16_t log10q15_to_q11(const int32_t y)
+{
+    return static_cast<int16_t>((static_cast<int64_t>(y) * LOG10_2_Q16 + (1 << 19)) >> 20);
+}
+
+// Convert to float, call log2f and convert back with rounding.
+int16_t log2q15_0(const int16_t x)
+{
+    return static_cast<int16_t>(lrintf(log2f(x * (1.0F / 32768.0F)) * 2048.0F));
+}
+
+int16_t log2q15_1(const int16_t x)
+{
+    return log2q15_to_q11(log2q15_lut(x));
+}
+
+int16_t log2q15_2(const int16_t x)
+{
+    return log2q15_to_q11(log2q15_poly(x));
+}
+
+int16_t log2q15_3(const int16_t x)
+{
+    return log2q15_to_q11(log2q15_turner(x));
+}
+
+// Convert to float, call log10f and convert back with rounding.
+int16_t log10q15_0(const int16_t x)
+{
+    return static_cast<int16_t>(lrintf(log10f(x * (1.0F / 32768.0F)) * 2048.0F));
+}
+
+int16_t log10q15_1(const int16_t x)
+{
+    return log10q15_to_q11(log2q15_lut(x));
+}
+
+int16_t log10q15_2(const int16_t x)
+{
+    return log10q15_to_q11(log2q15_poly(x));
+}
+
+int16_t log10q15_3(const int16_t x)
+{
+    return log10q15_to_q11(log2q15_turner(x));
+}
+
+class Log2Q15Test : public Test<int16_t, int16_t, double>
+{
+  public:
+    Log2Q15Test(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "log2 Q1.15", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &log2q15_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "float + std::log2f", &log2q15_0));
+        results.push_back(run("#1", "clz + table", &log2q15_1));
+        results.push_back(run("#2", "clz + polynomial", &log2q15_2));
+        results.push_back(run("#3", "Clay S. Turner", &log2q15_3));
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        input_range_t result;
+        result.first = range.first < 1 ? 1 : range.first;
+        result.second = range.second < 1 ? 1 : range.second;
+        return result;
+    }
+};
+
+class Log10Q15Test : public Test<int16_t, int16_t, double>
+{
+  public:
+    Log10Q15Test(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "log10 Q1.15", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &log10q15_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "float + std::log10f", &log10q15_0));
+        results.push_back(run("#1", "clz + table", &log10q15_1));
+        results.push_back(run("#2", "clz + polynomial", &log10q15_2));
+        results.push_back(run("#3", "Clay S. Turner", &log10q15_3));
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        input_range_t result;
+        result.first = range.first < 1 ? 1 : range.first;
+        result.second = range.second < 1 ? 1 : range.second;
+        return result;
+    }
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+// Normalization of 3D float vectors v / |v| = v * 1 / sqrt(x^2 + y^2 + z^2), e.g. for lighting or physics.
+// The vectors are stored as structure of arrays (SoA), so x, y and z components are in separate arrays,
+// which is the layout SIMD code needs. The error is measured in the length of the normalized vector, which should be 1.
+// See: https://en.wikipedia.org/wiki/Fast_inverse_square_root
+// See: Intel Intrinsics Guide, _mm256_rsqrt_ps: https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
+
+// All functions here assume non-zero vectors.
+
+#include "test.h"
+#include "test_invsqrtf.h"
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+// Reference length of normalized vectors
+long double normalizef_reference(const std::tuple<long double, long double, long double> /*v*/)
+{
+    return 1.0L;
+}
+
+// Normalize using any of the invsqrtf_* functions from test_invsqrtf.h.
+// Passing the function as template parameter lets the compiler inline it.
+template <float (*InvSqrt)(float)>
+void normalizef_invsqrt(const float* x, const float* y, const float* z, float* nx, float* ny, float* nz, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float r = InvSqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        nx[i] = x[i] * r;
+        ny[i] = y[i] * r;
+        nz[i] = z[i] * r;
+    }
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+// Normalize 8 vectors at a time using 1 / sqrt(x) with Steps Newton iterations y = y * (1.5 - 0.5 * x * y^2).
+// Steps == -1 uses a full-precision square root and division, Steps >= 0 uses the 12 bit hardware estimate rsqrtps.
+template <int Steps>
+void normalizef_avx(const float* x, const float* y, const float* z, float* nx, float* ny, float* nz, std::size_t count)
+{
+    const __m256 half = _mm256_set1_ps(0.5F);
+    const __m256 threeHalfs = _mm256_set1_ps(1.5F);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 vx = _mm256_loadu_ps(x + i);
+        const __m256 vy = _mm256_loadu_ps(y + i);
+        const __m256 vz = _mm256_loadu_ps(z + i);
+        const __m256 l2 = _mm256_fmadd_ps(vz, vz, _mm256_fmadd_ps(vy, vy, _mm256_mul_ps(vx, vx)));
+        __m256 r;
+        if constexpr (Steps < 0)
+        {
+            r = _mm256_div_ps(_mm256_set1_ps(1.0F), _mm256_sqrt_ps(l2));
+        }
+        else
+        {
+            r = _mm256_rsqrt_ps(l2);
+            const __m256 halfL2 = _mm256_mul_ps(half, l2);
+            for (int s = 0; s < Steps; ++s)
+            {
+                r = _mm256_mul_ps(r, _mm256_fnmadd_ps(halfL2, _mm256_mul_ps(r, r), threeHalfs));
+            }
+        }
+        _mm256_storeu_ps(nx + i, _mm256_mul_ps(vx, r));
+        _mm256_storeu_ps(ny + i, _mm256_mul_ps(vy, r));
+        _mm256_storeu_ps(nz + i, _mm256_mul_ps(vz, r));
+    }
+    normalizef_invsqrt<invsqrtf_0>(x + i, y + i, z + i, nx + i, ny + i, nz + i, count - i);
+}
+#endif
+// The length of the normalized vector is stored as double, but the vectors are float, so ULPs are float ULPs.
+// The length is returned as double, but calculated from float vectors, so the ULP error is measured in float ULPs.
+class NormalizefTest : public Test<std::tuple<float, float, float>, double, double, float>
+{
+  public:
+    NormalizefTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "normalize3f", inputGenerator,
+            inputRange, samplesInRange, &normalizef_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(runSoA("#0", "1/std::sqrtf", &normalizef_invsqrt<invsqrtf_0>));
+        results.push_back(runSoA("#1", "Quake3", &normalizef_invsqrt<invsqrtf_1>));
+        results.push_back(runSoA("#2", "Quake3 + 2x Newton", &normalizef_invsqrt<invsqrtf_2>));
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runSoA("#3", "AVX 1 / sqrtps", &normalizef_avx<-1>));
+        results.push_back(runSoA("#4", "AVX rsqrtps", &normalizef_avx<0>));
+        results.push_back(runSoA("#5", "AVX rsqrtps + Newton", &normalizef_avx<1>));
+#endif
+        return results;
+    }
+
+  protected:
+    /// @brief Baseline for the SoA functions: Loads and stores the same values, but does not calculate anything.
+    /// Uses memcpy, so the copy is as fast as the widest loads and stores the CPU has, like in the SIMD functions.
+    static void copyVectors(const float* x, const float* y, const float* z, float* nx, float* ny, float* nz, std::size_t count)
+    {
+        std::memcpy(nx, x, count * sizeof(float));
+        std::memcpy(ny, y, count * sizeof(float));
+        std::memcpy(nz, z, count * sizeof(float));
+    }
+
+    /// @brief Run a function of type void(const float* x, const float* y, const float* z, float* nx, float* ny, float* nz, std::size_t count)
+    /// that normalizes all vectors in SoA arrays. One call in the results is one vector.
+    template <typename SoAApproximation>
+    Result<input_t, storage_t> runSoA(const std::string& name, const std::string& description, SoAApproximation approx) const
+    {
+        auto result = createResult(name, description);
+        result.kernelAddress = kernelAddress(approx);
+        const auto count = result.samplesInRange;
+        // split input vectors into SoA arrays
+        std::vector<float> x(count), y(count), z(count);
+        std::vector<float> nx(count), ny(count), nz(count);
+        for (uint_fast64_t i = 0; i < count; ++i)
+        {
+            x[i] = std::get<0>(inputValues()[i]);
+            y[i] = std::get<1>(inputValues()[i]);
+            z[i] = std::get<2>(inputValues()[i]);
+        }
+        PerfCounter branchMissCounter(PerfCounter::Event::BranchMisses);
+        setTiming(result, measureLoops([&](uint_fast64_t loopCount)
+                                       {
+                                           for (uint_fast64_t j = 0; j < loopCount; ++j)
+                                           {
+                                               approx(x.data(), y.data(), z.data(), nx.data(), ny.data(), nz.data(), count);
+                                           }
+                                       },
+                                       [&](uint_fast64_t loopCount)
+                                       {
+                                           for (uint_fast64_t j = 0; j < loopCount; ++j)
+                                           {
+                                               copyVectors(x.data(), y.data(), z.data(), nx.data(), ny.data(), nz.data(), count);
+                                           }
+                                       },
+                                       &branchMissCounter));
+        // the baseline may have run last and overwritten the output
+        approx(x.data(), y.data(), z.data(), nx.data(), ny.data(), nz.data(), count);
+        // now check precision using the length of the normalized vectors
+        std::vector<output_t> lengths(count);
+        for (uint_fast64_t i = 0; i < count; ++i)
+        {
+            lengths[i] = std::sqrt(double(nx[i]) * nx[i] + double(ny[i]) * ny[i] + double(nz[i]) * nz[i]);
+        }
+        calculateErrors(result, lengths);
+        return result;
+    }
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+// Power function x^y of float values, e.g. for converting between dB and gain.
+// The approximations calculate 2^(y * log2(x)) using the log2 and exp2 kernels from test_log2f.h and test_exp2f.h.
+// The absolute error of log2(x) is multiplied by y and turns into a relative error of the result,
+// so the log2 polynomial needs a higher degree than the exp2 polynomial.
+// See: http://openaudio.blogspot.com/2017/02/faster-log10-and-pow.html
+
+// All functions here assume positive, normal x values and that y * log2(x) is in [-126, 128).
+// The input values are (x, y) tuples. (0, 0) works too and returns 1.
+
+#include "test.h"
+#include "test_exp2f.h"
+#include "test_log2f.h"
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+// Calculate the reference value for comparison.
+long double powf_reference(const std::tuple<long double, long double> xy)
+{
+    return powl(std::get<0>(xy), std::get<1>(xy));
+}
+
+// Standard powf function for comparison.
+float powf_0(const std::tuple<float, float> xy)
+{
+    return std::pow(std::get<0>(xy), std::get<1>(xy));
+}
+
+// 3rd degree log2 + 3rd degree exp2 polynomial
+template <typename V>
+inline V powf_poly33(const V x, const V y)
+{
+    return exp2f_poly3(multiply(y, log2f_poly3(x)));
+}
+
+// 5th degree log2 + 4th degree exp2 polynomial
+template <typename V>
+inline V powf_poly54(const V x, const V y)
+{
+    return exp2f_poly4(multiply(y, log2f_poly5(x)));
+}
+
+// 7th degree log2 + 5th degree exp2 polynomial
+template <typename V>
+inline V powf_poly75(const V x, const V y)
+{
+    return exp2f_poly5(multiply(y, log2f_poly7(x)));
+}
+
+float powf_1(const std::tuple<float, float> xy)
+{
+    return powf_poly33(std::get<0>(xy), std::get<1>(xy));
+}
+
+float powf_2(const std::tuple<float, float> xy)
+{
+    return powf_poly54(std::get<0>(xy), std::get<1>(xy));
+}
+
+float powf_3(const std::tuple<float, float> xy)
+{
+    return powf_poly75(std::get<0>(xy), std::get<1>(xy));
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+// The same kernels 8 values at a time
+void powf_4(const std::tuple<float, float>* xy, float* z, std::size_t count)
+{
+    transformBatch(xy, z, count, [](auto x, auto y)
+                   { return powf_poly33(x, y); });
+}
+
+void powf_5(const std::tuple<float, float>* xy, float* z, std::size_t count)
+{
+    transformBatch(xy, z, count, [](auto x, auto y)
+                   { return powf_poly54(x, y); });
+}
+
+void powf_6(const std::tuple<float, float>* xy, float* z, std::size_t count)
+{
+    transformBatch(xy, z, count, [](auto x, auto y)
+                   { return powf_poly75(x, y); });
+}
+#endif
+
+class PowfTest : public Test<std::tuple<float, float>, float, double>
+{
+  public:
+    PowfTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "x^y", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &powf_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::powf", &powf_0));
+        results.push_back(run("#1", "3rd degree log2 + 3rd degree exp2", &powf_1));
+        results.push_back(run("#2", "5th degree log2 + 4th degree exp2", &powf_2));
+        results.push_back(run("#3", "7th degree log2 + 5th degree exp2", &powf_3));
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runBatch("#4", "AVX2 3rd degree log2 + 3rd degree exp2", &powf_4));
+        results.push_back(runBatch("#5", "AVX2 5th degree log2 + 4th degree exp2", &powf_5));
+        results.push_back(runBatch("#6", "AVX2 7th degree log2 + 5th degree exp2", &powf_6));
+#endif
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        auto xA = std::get<0>(range.first);
+        auto xB = std::get<0>(range.second);
+        auto yA = std::get<1>(range.first);
+        auto yB = std::get<1>(range.second);
+        return {{std::min(xA, xB), std::min(yA, yB)}, {std::max(xA, xB), std::max(yA, yB)}};
+    }
+};
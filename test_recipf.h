@@ -0,0 +1,185 @@
+#pragma once
+
+// Reciprocal 1 / x of float values.
+// See: https://en.wikipedia.org/wiki/Division_algorithm#Newton%E2%80%93Raphson_division
+// See: https://bits.stephan-brumme.com/inverse.html
+// See: Intel Intrinsics Guide, _mm_rcp_ss / _mm256_rcp_ps: https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
+
+// All functions here assume positive, non-zero input values where the result is a normal float value.
+
+#include "test.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Calculate the reference value for comparison.
+long double recipf_reference(const long double x)
+{
+    return 1.0L / x;
+}
+
+// Standard division for comparison.
+float recipf_0(const float x)
+{
+    return 1.0F / x;
+}
+
+// Subtracting the bit pattern from a magic constant negates the exponent and approximates 1 / mantissa linearly.
+// Max. relative error of the initial guess is ~5%.
+inline float recipf_magic(const float x)
+{
+    uint32_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    i = 0x7EF311C3 - i;
+    float y;
+    std::memcpy(&y, &i, sizeof(y));
+    return y;
+}
+
+// Magic constant + Newton iterations y = y * (2 - x * y) that double the number of correct bits each step.
+// Written as e = 1 - x * y, y = y + y * e, so the compiler can use fused multiply-adds and no division is needed.
+// Max. relative error is ~2.5e-3 after 1, ~6.5e-6 after 2 and float precision after 3 steps.
+template <int Steps>
+inline float recipf_newton(const float x)
+{
+    float y = recipf_magic(x);
+    for (int i = 0; i < Steps; i++)
+    {
+        const float e = 1.0F - x * y;
+        y = y + y * e;
+    }
+    return y;
+}
+
+float recipf_1(const float x)
+{
+    return recipf_magic(x);
+}
+
+float recipf_2(const float x)
+{
+    return recipf_newton<1>(x);
+}
+
+float recipf_3(const float x)
+{
+    return recipf_newton<2>(x);
+}
+
+float recipf_4(const float x)
+{
+    return recipf_newton<3>(x);
+}
+
+#if defined(__SSE__)
+// Hardware reciprocal estimate (12 bits) + one Newton iteration
+float recipf_5(const float x)
+{
+    const float y = _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(x)));
+    return y + y * (1.0F - x * y);
+}
+#endif
+
+#if defined(__AVX2__) && defined(__FMA__)
+// Division of 8 values at a time for comparison.
+// Note that with -ffast-math GCC replaces vector divisions by rcpps + Newton itself (see -mrecip),
+// so this measures the compiler's version unless compiled with -mrecip=none.
+void recipf_6(const float* x, float* y, std::size_t count)
+{
+    const __m256 one = _mm256_set1_ps(1.0F);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(y + i, _mm256_div_ps(one, _mm256_loadu_ps(x + i)));
+    }
+    for (; i < count; ++i)
+    {
+        y[i] = recipf_0(x[i]);
+    }
+}
+
+// Hardware reciprocal estimate of 8 values at a time + one Newton iteration using FMA
+void recipf_7(const float* x, float* y, std::size_t count)
+{
+    const __m256 one = _mm256_set1_ps(1.0F);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 vx = _mm256_loadu_ps(x + i);
+        const __m256 r = _mm256_rcp_ps(vx);
+        const __m256 e = _mm256_fnmadd_ps(vx, r, one);
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(r, e, r));
+    }
+    for (; i < count; ++i)
+    {
+        y[i] = recipf_5(x[i]);
+    }
+}
+
+// Magic constant of 8 values at a time + three Newton iterations using FMA
+void recipf_8(const float* x, float* y, std::size_t count)
+{
+    const __m256 one = _mm256_set1_ps(1.0F);
+    const __m256i magic = _mm256_set1_epi32(0x7EF311C3);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 vx = _mm256_loadu_ps(x + i);
+        __m256 r = _mm256_castsi256_ps(_mm256_sub_epi32(magic, _mm256_castps_si256(vx)));
+        r = _mm256_fmadd_ps(r, _mm256_fnmadd_ps(vx, r, one), r);
+        r = _mm256_fmadd_ps(r, _mm256_fnmadd_ps(vx, r, one), r);
+        r = _mm256_fmadd_ps(r, _mm256_fnmadd_ps(vx, r, one), r);
+        _mm256_storeu_ps(y + i, r);
+    }
+    for (; i < count; ++i)
+    {
+        y[i] = recipf_4(x[i]);
+    }
+}
+#endif
+
+class RecipfTest : public Test<float, float, double>
+{
+  public:
+    RecipfTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "1 / x", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &recipf_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "Division", &recipf_0));
+        results.push_back(run("#1", "Magic constant", &recipf_1));
+        results.push_back(run("#2", "Magic constant + 1x Newton", &recipf_2));
+        results.push_back(run("#3", "Magic constant + 2x Newton", &recipf_3));
+        results.push_back(run("#4", "Magic constant + 3x Newton", &recipf_4));
+#if defined(__SSE__)
+        results.push_back(run("#5", "SSE rcpss + Newton", &recipf_5));
+#endif
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runBatch("#6", "AVX division", &recipf_6));
+        results.push_back(runBatch("#7", "AVX rcpps + Newton", &recipf_7));
+        results.push_back(runBatch("#8", "AVX2 magic constant + 3x Newton", &recipf_8));
+#endif
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        const float minValue = std::numeric_limits<float>::min();
+        input_range_t result;
+        result.first = range.first < minValue ? minValue : range.first;
+        result.second = range.second < minValue ? minValue : range.second;
+        return result;
+    }
+};
@@ -0,0 +1,296 @@
+#pragma once
+
+// Sine and cosine of float values, returned as a pair (sin(x), cos(x)).
+// See: W. J. Cody, W. Waite, "Software Manual for the Elementary Functions", Prentice-Hall, 1980
+// See: Stephen L. Moshier, Cephes Math Library, sinf.c: http://www.netlib.org/cephes/
+// See: https://en.wikipedia.org/wiki/Bhaskara_I%27s_sine_approximation_formula
+
+// All functions here assume input values in the range [-100, 100]. Precision of the range reduction degrades for bigger values.
+// The error of a call is the maximum error of the sine and cosine value.
+
+#include "test.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+// == pi
+#define PI_F 3.14159265358979323846F
+// == 2 / pi
+#define TWO_OVER_PI_F 0.63661977236758134308F
+// pi / 2 split into three parts for Cody-Waite range reduction. The first two have only 12 significant bits,
+// so j * CW1 and j * CW2 are exact for |j| < 2^12
+#define PIO2_CW1 1.5703125F
+#define PIO2_CW2 4.837512969970703125E-4F
+#define PIO2_CW3 7.549790126404332E-8F
+
+// Calculate the reference value for comparison.
+std::pair<long double, long double> sincosf_reference(const long double x)
+{
+    return {sinl(x), cosl(x)};
+}
+
+// Standard functions for comparison.
+std::pair<float, float> sincosf_0(const float x)
+{
+    return {std::sin(x), std::cos(x)};
+}
+
+// Hide a value from the optimizer, so -ffast-math can not reassociate the operations before and after it.
+// Costs nothing, the value stays in its register.
+inline float sincosf_barrier(float v)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__SSE__) || defined(__x86_64__))
+    __asm__("" : "+x"(v));
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    __asm__("" : "+w"(v));
+#else
+    volatile float t = v;
+    v = t;
+#endif
+    return v;
+}
+
+// Subtract the parts of a Cody-Waite constant in order. -ffast-math would reassociate the subtractions
+// into x - j * (CW1 + CW2 + CW3), which loses all precision, but does not touch fused multiply-adds.
+// Without FMA the intermediate results are passed through sincosf_barrier() to keep the order.
+inline float sincosf_cody_waite(const float x, const float fj, const float cw1, const float cw2, const float cw3)
+{
+#if defined(__FMA__)
+    return std::fma(-fj, cw3, std::fma(-fj, cw2, std::fma(-fj, cw1, x)));
+#else
+    const float r1 = sincosf_barrier(x - fj * cw1);
+    const float r2 = sincosf_barrier(r1 - fj * cw2);
+    return r2 - fj * cw3;
+#endif
+}
+
+// Cody-Waite range reduction. Returns r = x - j * pi / 2 in [-pi/4, pi/4] and the quadrant j.
+inline float sincosf_reduce(const float x, int32_t& j)
+{
+    const float fj = std::nearbyint(x * TWO_OVER_PI_F);
+    j = static_cast<int32_t>(fj);
+    return sincosf_cody_waite(x, fj, PIO2_CW1, PIO2_CW2, PIO2_CW3);
+}
+
+// Least squares polynomials on [-pi/4, pi/4]. Max. absolute error 2.9e-6 (sin) and 2.6e-5 (cos).
+inline float sinf_poly5(const float r)
+{
+    const float z = r * r;
+    return r + r * z * (-0.16664028F + z * 0.0081789031F);
+}
+
+inline float cosf_poly4(const float r)
+{
+    const float z = r * r;
+    return 1.0F + z * (-0.4998159F + z * 0.040588398F);
+}
+
+// Cephes minimax polynomials on [-pi/4, pi/4]. Max. absolute error 2.7e-9 (sin) and 1.1e-10 (cos).
+inline float sinf_poly7(const float r)
+{
+    const float z = r * r;
+    return r + r * z * (-1.6666654611E-1F + z * (8.3321608736E-3F + z * -1.9515295891E-4F));
+}
+
+inline float cosf_poly6(const float r)
+{
+    const float z = r * r;
+    return 1.0F - 0.5F * z + z * z * (4.166664568298827E-2F + z * (-1.388731625493765E-3F + z * 2.443315711809948E-5F));
+}
+
+// Select sin / cos and their sign from the polynomials depending on the quadrant j.
+// sin(r + j * pi/2) = sin(r), cos(r), -sin(r), -cos(r) for j = 0, 1, 2, 3
+// cos(r + j * pi/2) = cos(r), -sin(r), -cos(r), sin(r) for j = 0, 1, 2, 3
+inline std::pair<float, float> sincosf_quadrant(const float s, const float c, const int32_t j)
+{
+    const float sinValue = (j & 1) ? c : s;
+    const float cosValue = (j & 1) ? s : c;
+    return {(j & 2) ? -sinValue : sinValue, ((j + 1) & 2) ? -cosValue : cosValue};
+}
+
+// Separate sin and cos functions that both do their own range reduction
+float sinf_1(const float x)
+{
+    int32_t j;
+    const float r = sincosf_reduce(x, j);
+    return sincosf_quadrant(sinf_poly5(r), cosf_poly4(r), j).first;
+}
+
+float cosf_1(const float x)
+{
+    int32_t j;
+    const float r = sincosf_reduce(x, j);
+    return sincosf_quadrant(sinf_poly5(r), cosf_poly4(r), j).second;
+}
+
+std::pair<float, float> sincosf_1(const float x)
+{
+    return {sinf_1(x), cosf_1(x)};
+}
+
+// Fused sincos with one range reduction and 5th / 4th degree polynomials
+std::pair<float, float> sincosf_2(const float x)
+{
+    int32_t j;
+    const float r = sincosf_reduce(x, j);
+    return sincosf_quadrant(sinf_poly5(r), cosf_poly4(r), j);
+}
+
+// Fused sincos with one range reduction and 7th / 6th degree polynomials
+std::pair<float, float> sincosf_3(const float x)
+{
+    int32_t j;
+    const float r = sincosf_reduce(x, j);
+    return sincosf_quadrant(sinf_poly7(r), cosf_poly6(r), j);
+}
+
+// Bhaskara I's rational approximation sin(x) = 16x(pi - x) / (5pi^2 - 4x(pi - x)) for x in [0, pi].
+// Max. absolute error is ~0.0016.
+inline float sinf_bhaskara(const float x)
+{
+    const float ax = std::abs(x);
+    const float p = ax * (PI_F - ax);
+    const float s = (16.0F * p) / (5.0F * PI_F * PI_F - 4.0F * p);
+    return x < 0.0F ? -s : s;
+}
+
+// Reduce to [-pi, pi], then use Bhaskara's formula for sin(r) and sin(pi/2 - |r|) for cos(r).
+std::pair<float, float> sincosf_4(const float x)
+{
+    const float fk = std::nearbyint(x * (0.25F * TWO_OVER_PI_F));
+    const float r = sincosf_cody_waite(x, fk, 4.0F * PIO2_CW1, 4.0F * PIO2_CW2, 4.0F * PIO2_CW3);
+    return {sinf_bhaskara(r), sinf_bhaskara(0.5F * PI_F - std::abs(r))};
+}
+
+// Table of sin(2 * pi * i / 256) for i in [0, 256] for linear interpolation
+static const std::array<float, 257> SinTable256 = []()
+{
+    std::array<float, 257> table;
+    for (std::size_t i = 0; i < table.size(); ++i)
+    {
+        table[i] = static_cast<float>(std::sin(2.0 * M_PI * static_cast<double>(i) / 256.0));
+    }
+    return table;
+}();
+
+// Linear interpolation in a table with 256 entries per period. cos(x) = sin(x + pi/2) is 64 entries further.
+// Max. absolute error is ~7.5e-5.
+std::pair<float, float> sincosf_5(const float x)
+{
+    const float t = x * (256.0F / (2.0F * PI_F));
+    const float fi = std::floor(t);
+    const float f = t - fi;
+    const int32_t i = static_cast<int32_t>(fi) & 255;
+    const int32_t ic = (i + 64) & 255;
+    const float s = SinTable256[i] + f * (SinTable256[i + 1] - SinTable256[i]);
+    const float c = SinTable256[ic] + f * (SinTable256[ic + 1] - SinTable256[ic]);
+    return {s, c};
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+// AVX2 + FMA fused sincos processing 8 values at a time. The same algorithm as sincosf_2 / sincosf_3, but the
+// quadrant selection is done with blends and sign flips. Stores interleaved (sin, cos) pairs.
+template <bool HighDegree>
+void sincosf_avx2(const float* x, std::pair<float, float>* y, std::size_t count)
+{
+    static_assert(sizeof(std::pair<float, float>) == 2 * sizeof(float), "std::pair<float, float> must be 2 packed floats");
+    const __m256 twoOverPi = _mm256_set1_ps(TWO_OVER_PI_F);
+    const __m256 cw1 = _mm256_set1_ps(PIO2_CW1);
+    const __m256 cw2 = _mm256_set1_ps(PIO2_CW2);
+    const __m256 cw3 = _mm256_set1_ps(PIO2_CW3);
+    const __m256 one = _mm256_set1_ps(1.0F);
+    const __m256i signBit = _mm256_set1_epi32(0x80000000);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 vx = _mm256_loadu_ps(x + i);
+        const __m256 fj = _mm256_round_ps(_mm256_mul_ps(vx, twoOverPi), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        const __m256i j = _mm256_cvtps_epi32(fj);
+        __m256 r = _mm256_fnmadd_ps(fj, cw1, vx);
+        r = _mm256_fnmadd_ps(fj, cw2, r);
+        r = _mm256_fnmadd_ps(fj, cw3, r);
+        const __m256 z = _mm256_mul_ps(r, r);
+        __m256 s;
+        __m256 c;
+        if constexpr (HighDegree)
+        {
+            s = _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(-1.9515295891E-4F)), _mm256_set1_ps(8.3321608736E-3F));
+            s = _mm256_add_ps(_mm256_mul_ps(z, s), _mm256_set1_ps(-1.6666654611E-1F));
+            s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(r, z), s), r);
+            c = _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(2.443315711809948E-5F)), _mm256_set1_ps(-1.388731625493765E-3F));
+            c = _mm256_add_ps(_mm256_mul_ps(z, c), _mm256_set1_ps(4.166664568298827E-2F));
+            c = _mm256_mul_ps(_mm256_mul_ps(z, z), c);
+            c = _mm256_add_ps(_mm256_sub_ps(one, _mm256_mul_ps(_mm256_set1_ps(0.5F), z)), c);
+        }
+        else
+        {
+            s = _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(0.0081789031F)), _mm256_set1_ps(-0.16664028F));
+            s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(r, z), s), r);
+            c = _mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(0.040588398F)), _mm256_set1_ps(-0.4998159F));
+            c = _mm256_add_ps(_mm256_mul_ps(z, c), one);
+        }
+        // swap sin and cos in odd quadrants
+        const __m256 swap = _mm256_castsi256_ps(_mm256_slli_epi32(j, 31));
+        const __m256 sinValue = _mm256_blendv_ps(s, c, swap);
+        const __m256 cosValue = _mm256_blendv_ps(c, s, swap);
+        // flip signs. sin is negative in quadrants 2, 3, cos in quadrants 1, 2
+        const __m256 sinSign = _mm256_castsi256_ps(_mm256_and_si256(_mm256_slli_epi32(j, 30), signBit));
+        const __m256 cosSign = _mm256_castsi256_ps(_mm256_and_si256(_mm256_slli_epi32(_mm256_add_epi32(j, _mm256_set1_epi32(1)), 30), signBit));
+        const __m256 vs = _mm256_xor_ps(sinValue, sinSign);
+        const __m256 vc = _mm256_xor_ps(cosValue, cosSign);
+        // interleave to (sin, cos) pairs
+        const __m256 lo = _mm256_unpacklo_ps(vs, vc);
+        const __m256 hi = _mm256_unpackhi_ps(vs, vc);
+        float* dst = reinterpret_cast<float*>(y + i);
+        _mm256_storeu_ps(dst, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    for (; i < count; ++i)
+    {
+        y[i] = HighDegree ? sincosf_3(x[i]) : sincosf_2(x[i]);
+    }
+}
+
+void sincosf_6(const float* x, std::pair<float, float>* y, std::size_t count)
+{
+    sincosf_avx2<false>(x, y, count);
+}
+
+void sincosf_7(const float* x, std::pair<float, float>* y, std::size_t count)
+{
+    sincosf_avx2<true>(x, y, count);
+}
+#endif
+
+class SinCosfTest : public Test<float, std::pair<float, float>, double>
+{
+  public:
+    SinCosfTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "sincosf", inputGenerator,
+            inputRange, samplesInRange, &sincosf_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::sin + std::cos", &sincosf_0));
+        results.push_back(run("#1", "Cody-Waite + poly 5/4, separate", &sincosf_1));
+        results.push_back(run("#2", "Cody-Waite + poly 5/4, fused", &sincosf_2));
+        results.push_back(run("#3", "Cody-Waite + poly 7/6, fused", &sincosf_3));
+        results.push_back(run("#4", "Bhaskara I", &sincosf_4));
+        results.push_back(run("#5", "Table + linear interpolation", &sincosf_5));
+#if defined(__AVX2__) && defined(__FMA__)
+        results.push_back(runBatch("#6", "AVX2 + FMA poly 5/4", &sincosf_6));
+        results.push_back(runBatch("#7", "AVX2 + FMA poly 7/6", &sincosf_7));
+#endif
+        return results;
+    }
+};
@@ -0,0 +1,229 @@
+#pragma once
+
+// The functions in this file are double versions of the functions in test_sqrtf.h.
+// See there for sources, and also:
+// http://www.lomont.org/Math/Papers/2003/InvSqrt.pdf (magic number for doubles)
+// https://en.wikipedia.org/wiki/Methods_of_computing_square_roots
+
+// All functions here assume positive, non-zero input values.
+// The Quake3 functions overflow when squaring the initial guess for values close to DBL_MIN (< ~1e-307).
+// All functions operate on double values.
+
+#include "test.h"
+#include <cstddef>
+#include <cstdint>
+#include <math.h>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#ifdef APPROX_HAVE_QUADMATH
+#include <quadmath.h>
+#endif
+
+// Calculate the reference value for comparison.
+// A long double only has 64 bits of mantissa, so use quad precision if available.
+long double sqrtd_reference(const long double x)
+{
+#ifdef APPROX_HAVE_QUADMATH
+    return (long double)sqrtq((__float128)x);
+#else
+    return sqrtl(x);
+#endif
+}
+
+// Standard sqrt function for comparison.
+double sqrtd_0(const double x)
+{
+    return sqrt(x);
+}
+
+// Get approximation for log2(x) / 2 and add bias to improve error.
+// The bias is the one from sqrtf_1 shifted to the double mantissa.
+// See: https://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Approximations_that_depend_on_the_floating_point_representation
+double sqrtd_1(const double x)
+{
+    union
+    {
+        int64_t i;
+        double x;
+    } u;
+    u.x = x;
+    u.i = (INT64_C(1) << 61) + (u.i >> 1) - (INT64_C(1) << 51) - (INT64_C(0x4B0D2) << 29);
+    return u.x;
+}
+
+// Get approximation for log2(x) / 2 as initial guess,
+// add bias to improve error,
+// apply Babylonian method twice.
+// See: https://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Approximations_that_depend_on_the_floating_point_representation
+double sqrtd_2(const double x)
+{
+    union
+    {
+        int64_t i;
+        double x;
+    } u;
+    u.x = x;
+    u.i = (INT64_C(1) << 61) + (u.i >> 1) - (INT64_C(1) << 51) - (INT64_C(0x4B0D2) << 29);
+    u.x = 0.5 * (u.x + x / u.x);
+    u.x = 0.5 * (u.x + x / u.x);
+    return u.x;
+}
+
+// Get approximation for log2(x) / 2 as initial guess,
+// add bias to improve error,
+// apply Babylonian method three times, which is needed to get close to double precision.
+// See: https://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Approximations_that_depend_on_the_floating_point_representation
+double sqrtd_3(const double x)
+{
+    union
+    {
+        int64_t i;
+        double x;
+    } u;
+    u.x = x;
+    u.i = (INT64_C(1) << 61) + (u.i >> 1) - (INT64_C(1) << 51) - (INT64_C(0x4B0D2) << 29);
+    u.x = 0.5 * (u.x + x / u.x);
+    u.x = 0.5 * (u.x + x / u.x);
+    u.x = 0.5 * (u.x + x / u.x);
+    return u.x;
+}
+
+// Fast inverse square root aka "Quake 3 fast inverse square root", multiplied by x, which is sqrt(x).
+// This uses the double magic number 0x5FE6EC85E7DE30DA with two Newton iterations.
+// See: https://en.wikipedia.org/wiki/Fast_inverse_square_root
+// See: http://www.lomont.org/Math/Papers/2003/InvSqrt.pdf
+double sqrtd_4(const double x)
+{
+    const double xhalf = 0.5 * x;
+    union // get bits for floating value
+    {
+        double x;
+        int64_t i;
+    } u;
+    u.x = x;
+    u.i = INT64_C(0x5FE6EC85E7DE30DA) - (u.i >> 1); // gives initial guess y0
+    u.x = u.x * (1.5 - xhalf * u.x * u.x); // Newton method, repeating increases accuracy
+    u.x = u.x * (1.5 - xhalf * u.x * u.x);
+    return x * u.x;
+}
+
+// Fast inverse square root aka "Quake 3 fast inverse square root", multiplied by x, which is sqrt(x).
+// This uses the double magic number 0x5FE6EC85E7DE30DA with three Newton iterations.
+// See: https://en.wikipedia.org/wiki/Fast_inverse_square_root
+// See: http://www.lomont.org/Math/Papers/2003/InvSqrt.pdf
+double sqrtd_5(const double x)
+{
+    const double xhalf = 0.5 * x;
+    union // get bits for floating value
+    {
+        double x;
+        int64_t i;
+    } u;
+    u.x = x;
+    u.i = INT64_C(0x5FE6EC85E7DE30DA) - (u.i >> 1); // gives initial guess y0
+    u.x = u.x * (1.5 - xhalf * u.x * u.x); // Newton method, repeating increases accuracy
+    u.x = u.x * (1.5 - xhalf * u.x * u.x);
+    u.x = u.x * (1.5 - xhalf * u.x * u.x);
+    return x * u.x;
+}
+
+// Fast inverse square root aka "Quake 3 fast inverse square root", multiplied by x, which is sqrt(x).
+// Uses two iterations of Halley's method for precision.
+// See: https://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Iterative_methods_for_reciprocal_square_roots
+double sqrtd_6(const double x)
+{
+    union // get bits for floating value
+    {
+        double x;
+        int64_t i;
+    } u;
+    u.x = x;
+    u.i = INT64_C(0x5FE6EC85E7DE30DA) - (u.i >> 1); // gives initial guess y0
+    double xu2 = x * u.x * u.x;
+    u.x = (0.125 * 3.0) * u.x * (5.0 - xu2 * ((10.0 / 3.0) - xu2)); // Halley's method, repeating increases accuracy
+    xu2 = x * u.x * u.x;
+    u.x = (0.125 * 3.0) * u.x * (5.0 - xu2 * ((10.0 / 3.0) - xu2));
+    return x * u.x;
+}
+
+#if defined(__AVX2__)
+// Batch version of the standard sqrt function using AVX.
+void sqrtd_7(const double* x, double* y, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(y + i, _mm256_sqrt_pd(_mm256_loadu_pd(x + i)));
+    }
+    for (; i < count; ++i)
+    {
+        y[i] = sqrtd_0(x[i]);
+    }
+}
+
+// Batch version of sqrtd_5 (Quake3 + three Newton iterations) using AVX2.
+void sqrtd_8(const double* x, double* y, std::size_t count)
+{
+    const __m256i magic = _mm256_set1_epi64x(INT64_C(0x5FE6EC85E7DE30DA));
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d threeHalfs = _mm256_set1_pd(1.5);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d v = _mm256_loadu_pd(x + i);
+        const __m256d vhalf = _mm256_mul_pd(half, v);
+        __m256d u = _mm256_castsi256_pd(_mm256_sub_epi64(magic, _mm256_srli_epi64(_mm256_castpd_si256(v), 1)));
+        u = _mm256_mul_pd(u, _mm256_sub_pd(threeHalfs, _mm256_mul_pd(vhalf, _mm256_mul_pd(u, u))));
+        u = _mm256_mul_pd(u, _mm256_sub_pd(threeHalfs, _mm256_mul_pd(vhalf, _mm256_mul_pd(u, u))));
+        u = _mm256_mul_pd(u, _mm256_sub_pd(threeHalfs, _mm256_mul_pd(vhalf, _mm256_mul_pd(u, u))));
+        _mm256_storeu_pd(y + i, _mm256_mul_pd(v, u));
+    }
+    for (; i < count; ++i)
+    {
+        y[i] = sqrtd_5(x[i]);
+    }
+}
+#endif
+
+class SqrtdTest : public Test<double, double, long double>
+{
+  public:
+    SqrtdTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "sqrtd", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &sqrtd_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::sqrt", &sqrtd_0));
+        results.push_back(run("#1", "log2(x) + bias", &sqrtd_1));
+        results.push_back(run("#2", "log2(x) + bias + 2x Babylonian", &sqrtd_2));
+        results.push_back(run("#3", "log2(x) + bias + 3x Babylonian", &sqrtd_3));
+        results.push_back(run("#4", "Quake3 + 2x Newton", &sqrtd_4));
+        results.push_back(run("#5", "Quake3 + 3x Newton", &sqrtd_5));
+        results.push_back(run("#6", "Quake3 + 2x Halley", &sqrtd_6));
+#if defined(__AVX2__)
+        results.push_back(runBatch("#7", "AVX _mm256_sqrt_pd", &sqrtd_7));
+        results.push_back(runBatch("#8", "AVX2 Quake3 + 3x Newton", &sqrtd_8));
+#endif
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        input_range_t result;
+        result.first = range.first <= 0 ? std::numeric_limits<input_t>::min() : range.first;
+        result.second = range.second <= 0 ? std::numeric_limits<input_t>::min() : range.second;
+        result.first = result.first > std::numeric_limits<input_t>::max() ? std::numeric_limits<input_t>::max() : result.first;
+        result.second = result.second > std::numeric_limits<input_t>::max() ? std::numeric_limits<input_t>::max() : result.second;
+        return result;
+    }
+};
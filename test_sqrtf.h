@@ -13,7 +13,9 @@
 // All functions operate on float values, but some can be used on double values too.
 
 #include "test.h"
+#include "test_recipf.h"
 #include <cstdint>
+#include <cstring>
 #include <math.h>
 #include <vector>
 
@@ -197,12 +199,14 @@ float sqrtf_9(const float x)
 }
 
 // Apply Newtons method until answer does not change.
+// The number of iterations is limited, because the answer never settles for negative values, inf or NaN.
+// From x / 2 even FLT_MAX converges in < 80 iterations.
 // See: http://forums.techarena.in/software-development/1290144.htm (Author: "Reegan")
 float sqrtf_10(const float x)
 {
     float n = x / 2.0;
     float lstX = 0.0;
-    while (n != lstX)
+    for (int i = 0; i < 128 && n != lstX; ++i)
     {
         lstX = n;
         n = (n + x / n) / 2.0;
@@ -211,10 +215,13 @@ float sqrtf_10(const float x)
 }
 
 // Apply Newtons method until ACCURACY is reached.
+// The number of iterations is limited, because for x >= 2^34 the float spacing around sqrt(x) is > ACCURACY and
+// for inf or NaN the interval never shrinks. Halving [1, FLT_MAX] down to ACCURACY takes 135 iterations.
 // See: http://www.cs.uni.edu/~jacobson/C++/newton.html
 float sqrtf_11(const float x)
 {
     const float ACCURACY = 0.01;
+    const int MAX_ITERATIONS = 160;
     float lower, upper, guess;
     if (x < 1)
     {
@@ -226,7 +233,7 @@ float sqrtf_11(const float x)
         lower = 1;
         upper = x;
     }
-    while ((upper - lower) > ACCURACY)
+    for (int i = 0; i < MAX_ITERATIONS && (upper - lower) > ACCURACY; ++i)
     {
         guess = (lower + upper) / 2;
         if (guess * guess > x)
@@ -237,13 +244,76 @@ float sqrtf_11(const float x)
     return (lower + upper) / 2;
 }
 
+// The functions below are the same as the ones above that divide, but replace every division a / b
+// by a * (1 / b) using the division-free reciprocal recipf_newton<3> from test_recipf.h.
+
+// sqrtf_2 without division
+float sqrtf_12(const float x)
+{
+    union
+    {
+        int i;
+        float x;
+    } u;
+    u.x = x;
+    u.i = (1 << 29) + (u.i >> 1) - (1 << 22);
+    u.x = u.x + x * recipf_newton<3>(u.x);
+    u.x = 0.25 * u.x + x * recipf_newton<3>(u.x);
+    return u.x;
+}
+
+// sqrtf_3 without division.
+// The combined fraction of sqrtf_3 is rewritten with t = x / u^2 as u * (t^2 + 6t + 1) / (4 * (t + 1)), because its
+// divisor 4u(x + u^2) ~ 8x^1.5 underflows for x < ~1e-26, which turns the result into 0 * inf = NaN. t is ~1 and
+// x / u ~ sqrt(x), so all values stay normal for all positive normal inputs, at the cost of a second reciprocal.
+float sqrtf_13(const float x)
+{
+    union
+    {
+        int i;
+        float x;
+    } u;
+    u.x = x;
+    u.i = (1 << 29) + (u.i >> 1) - (1 << 22) - 0x4B0D2;
+    const float r = recipf_newton<3>(u.x);
+    const float t = x * r * r;
+    u.x = u.x * ((t + 6.0F) * t + 1.0F) * recipf_newton<3>(4.0F * (t + 1.0F));
+    return u.x;
+}
+
+// sqrtf_4 without division
+float sqrtf_14(const float x)
+{
+    union
+    {
+        int i;
+        float x;
+    } u;
+    u.x = x;
+    u.i = (1 << 29) + (u.i >> 1) - (1 << 22) - 0x4B0D2;
+    u.x = (u.x * u.x + x) * recipf_newton<3>(2 * u.x);
+    return u.x;
+}
+
+// sqrtf_8 without division
+float sqrtf_15(const float x)
+{
+    uint32_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    i += 127 << 23; // adjust bias
+    i >>= 1; // approximation of square root
+    float f;
+    std::memcpy(&f, &i, sizeof(f));
+    return (f * f + x) * recipf_newton<3>(2 * f);
+}
+
 class SqrtfTest : public Test<float, float, double>
 {
   public:
     SqrtfTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
         : Test(
             "sqrtf", inputGenerator,
-            fixupInputRange(inputRange), samplesInRange, &sqrtf_reference, &dummyFunc)
+            fixupInputRange(inputRange), samplesInRange, &sqrtf_reference)
     {
     }
 
@@ -262,15 +332,14 @@ class SqrtfTest : public Test<float, float, double>
         results.push_back(run("#9", "Taylor3", &sqrtf_9));
         results.push_back(run("#10", "Newton while change", &sqrtf_10));
         results.push_back(run("#11", "Newton accuracy 0.01", &sqrtf_11));
+        results.push_back(run("#12", "log2(x) + Babylonian, no division", &sqrtf_12));
+        results.push_back(run("#13", "log2(x) + bias + Babylonian, no division", &sqrtf_13));
+        results.push_back(run("#14", "log2(x) + bias + Bakhshali, no division", &sqrtf_14));
+        results.push_back(run("#15", "Intel SOC + Bakhshali, no division", &sqrtf_15));
         return results;
     }
 
   protected:
-    static input_t dummyFunc(const input_t x)
-    {
-        return x;
-    }
-
     static input_range_t fixupInputRange(const input_range_t& range)
     {
         input_range_t result;
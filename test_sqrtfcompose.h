@@ -0,0 +1,71 @@
+#pragma once
+
+// Square root approximations composed from the seeds and refinements in sqrtcompose.h.
+// The suite registers every valid combination of seed, refinement and 0 to MaxSqrtSteps steps,
+// so the fastest combination for a given precision can be found without writing each one by hand.
+// The input range should start well above FLT_MIN, otherwise the max. error of most combinations is dominated
+// by denormal intermediate values that are flushed to zero (see sqrtcompose.h).
+
+#include "sqrtcompose.h"
+#include "test.h"
+#include "test_sqrtf.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+template <typename... Ts>
+struct TypeList
+{
+};
+
+using SqrtSeeds = TypeList<Log2Seed<0>, Log2Seed<0x4B0D2>, IntelSeed, QuakeSeed<0x5F3759DF>, QuakeSeed<0x5F375A86>>;
+using SqrtRefinements = TypeList<Newton, Halley, Bakhshali>;
+constexpr int MaxSqrtSteps = 3;
+
+class SqrtfComposeTest : public SqrtfTest
+{
+  public:
+    SqrtfComposeTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : SqrtfTest(inputGenerator, inputRange, samplesInRange)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "std::sqrtf", &sqrtf_0));
+        addSeeds(results, SqrtSeeds{});
+        return results;
+    }
+
+  protected:
+    template <typename... Seeds>
+    void addSeeds(std::vector<Result<input_t, storage_t>>& results, TypeList<Seeds...>) const
+    {
+        (addSeed<Seeds>(results, SqrtRefinements{}), ...);
+    }
+
+    template <typename Seed, typename... Refinements>
+    void addSeed(std::vector<Result<input_t, storage_t>>& results, TypeList<Refinements...>) const
+    {
+        // the seed alone is the same for all refinements
+        add<Seed, Newton, 0>(results);
+        (addRefinement<Seed, Refinements>(results, std::make_integer_sequence<int, MaxSqrtSteps>{}), ...);
+    }
+
+    template <typename Seed, typename Refinement, int... StepIndices>
+    void addRefinement(std::vector<Result<input_t, storage_t>>& results, std::integer_sequence<int, StepIndices...>) const
+    {
+        if constexpr (isValidSqrt<Seed, Refinement>())
+        {
+            (add<Seed, Refinement, StepIndices + 1>(results), ...);
+        }
+    }
+
+    template <typename Seed, typename Refinement, int Steps>
+    void add(std::vector<Result<input_t, storage_t>>& results) const
+    {
+        using S = Sqrt<Seed, Refinement, Steps>;
+        results.push_back(run("#" + std::to_string(results.size()), S::name(), &S::compute));
+    }
+};
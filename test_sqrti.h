@@ -5,29 +5,49 @@
 // And "Jack W. Crenshaw - Math Toolkit for Real-Time Development": http%3A%2F%2Ffmipa.umri.ac.id%2Fwp-content%2Fuploads%2F2016%2F03%2FJack-W.-Crenshaw-Math-toolkit-for-real-time-programming.9781929629091.35924.pdf
 
 // All functions here assume positive, non-zero input values.
-// All functions operate on 32bit values, but some can be used on smaller or bigger data types too.
+// All functions are templated on the unsigned integer type and can be used with 16, 32 or 64 bit values.
 
+#include "bitops.h"
 #include "test.h"
 #include <cstdint>
+#include <limits>
 #include <math.h>
+#include <type_traits>
 #include <vector>
 
 // Calculate the reference value for comparison.
 // Note that we could square the approximate result to get the input number
 // and use that for precision calculation, but then RMS etc. would have a
 // different meaning. Here we count on the std implementation to be very precise.
-uint32_t sqrti_reference(const uint32_t x)
+// A long double has a 64 bit mantissa, so 64 bit values are converted exactly. We
+// still correct the result in case sqrtl rounded up to the next integer.
+template <typename T>
+T sqrti_reference(const T x)
 {
-    return sqrt(x);
+    T r = static_cast<T>(sqrtl(x));
+    while (r > 0 && r > x / r)
+    {
+        r--;
+    }
+    return r;
+}
+
+// Standard sqrt function for comparison.
+// Note that a double can not represent all 64 bit values, so results for big values will be off.
+template <typename T>
+T sqrti_0(const T x)
+{
+    return static_cast<T>(sqrt(static_cast<double>(x)));
 }
 
 // https://www.cs.uni-potsdam.de/ti/kreitz/PDF/03cucs-intsqrt.pdf
 
 // Optimized binomial theorem
 // See: https://www.drdobbs.com/parallel/algorithm-alley/184409869
-uint32_t sqrti_1(const uint32_t x)
+template <typename T>
+T sqrti_1(const T x)
 {
-    uint32_t l2, u, v, u2, n;
+    T l2, u, v, u2, n;
     if (2 > x)
     {
         return x;
@@ -38,7 +58,7 @@ uint32_t sqrti_1(const uint32_t x)
     {
         l2++;
     }
-    u = 1L << l2;
+    u = T(1) << l2;
     v = u;
     u2 = u << l2;
     while (l2--)
@@ -58,13 +78,14 @@ uint32_t sqrti_1(const uint32_t x)
 // Square root by abacus algorithm, Martin Guy @ UKC, June 1985.
 // From a book on programming abaci by Mr C. Woo.
 // See: http://freaknet.org/martin/tape/gos/misc/personal/msc/sqrt
-uint32_t sqrti_2(uint32_t x)
+template <typename T>
+T sqrti_2(T x)
 {
     // Logically, these are unsigned. We need the sign bit to test whether (op - res - one) underflowed.
-    uint32_t op = x;
-    uint32_t res = 0;
+    T op = x;
+    T res = 0;
     // "one" starts at the highest power of four <= than the argument
-    uint32_t one = 1 << 30; // second-to-top bit set
+    T one = T(1) << (std::numeric_limits<T>::digits - 2); // second-to-top bit set
     while (one > op) one >>= 2;
     while (one != 0)
     {
@@ -82,14 +103,16 @@ uint32_t sqrti_2(uint32_t x)
 // From Jack W. Crenshaw's 1998 article in Embedded:
 // http://www.embedded.com/electronics-blogs/programmer-s-toolbox/4219659/Integer-Square-Roots
 // See also: https://gist.github.com/foobaz/3287f153d125277eefea
-uint32_t sqrti_3(uint32_t x)
+template <typename T>
+T sqrti_3(T x)
 {
-    uint32_t rem = 0;
-    uint32_t root = 0;
-    for (int i = 32 / 2; i > 0; i--)
+    constexpr int digits = std::numeric_limits<T>::digits;
+    T rem = 0;
+    T root = 0;
+    for (int i = digits / 2; i > 0; i--)
     {
         root <<= 1;
-        rem = (rem << 2) | (x >> (32 - 2));
+        rem = (rem << 2) | (x >> (digits - 2));
         x <<= 2;
         if (root < rem)
         {
@@ -103,15 +126,17 @@ uint32_t sqrti_3(uint32_t x)
 // Ross M. Fosler, Microchip Technology Inc.
 // See: http://ww1.microchip.com/downloads/en/AppNotes/91040a.pdf
 // See also: https://gist.github.com/foobaz/3287f153d125277eefea
-uint32_t sqrti_4(uint32_t x)
+template <typename T>
+T sqrti_4(T x)
 {
-    uint32_t res = 0;
-    uint32_t add = 0x8000;
-    uint32_t i;
-    for (i = 0; i < 16; i++)
+    constexpr int digits = std::numeric_limits<T>::digits;
+    T res = 0;
+    T add = T(1) << (digits / 2 - 1);
+    int i;
+    for (i = 0; i < digits / 2; i++)
     {
-        uint32_t temp = res | add;
-        uint32_t g2 = temp;
+        T temp = res | add;
+        T g2 = temp;
         g2 *= temp;
         if (x >= g2)
         {
@@ -124,13 +149,14 @@ uint32_t sqrti_4(uint32_t x)
 
 // Tristan Muntsinger (Tristan.Muntsinger@gmail.com)
 // See: http://www.codecodex.com/wiki/Calculate_an_integer_square_root
-uint32_t sqrti_5(uint32_t n)
+template <typename T>
+T sqrti_5(T n)
 {
-    uint32_t c = 0x8000;
-    uint32_t g = 0x8000;
+    T c = T(1) << (std::numeric_limits<T>::digits / 2 - 1);
+    T g = c;
     for (;;)
     {
-        if (g * g > n)
+        if (T(g * g) > n)
         {
             g ^= c;
         }
@@ -143,32 +169,100 @@ uint32_t sqrti_5(uint32_t n)
     }
 }
 
-class SqrtiTest : public Test<uint32_t, uint32_t, double>
+
+// Newton's method seeded with 2^ceil(bits(x) / 2) which is >= sqrt(x), so the iteration converges from above.
+// The seed is calculated using count leading zeros and the number of iterations is fixed
+// depending on the type, so there are no data-dependent branches.
+// See: https://en.wikipedia.org/wiki/Integer_square_root#Algorithm_using_Newton's_method
+template <typename T>
+T sqrti_6(const T x)
+{
+    constexpr int digits = std::numeric_limits<T>::digits;
+    // the seed is at most 2x too big. the relative error is then < 3e-3 after 3, < 5e-8 after 4 and < 1e-15 after 5 iterations
+    constexpr int iterations = digits <= 16 ? 3 : (digits <= 32 ? 4 : 5);
+    const int bits = digits - countLeadingZeros(T(x | 1));
+    T y = T(1) << ((bits + 1) / 2);
+    for (int i = 0; i < iterations; ++i)
+    {
+        // keep y at 1 for x == 0, so we don't divide by zero
+        y = T((y + x / y) >> 1) | T(x == 0);
+    }
+    // integer Newton can end up at floor(sqrt(x)) + 1
+    return y - T(y > x / y);
+}
+
+// Square root by abacus algorithm (see sqrti_2) without branches.
+// "one" always starts at the top bit and the loop runs a fixed number of iterations,
+// the conditional subtraction is done using a mask.
+template <typename T>
+T sqrti_7(T x)
+{
+    constexpr int digits = std::numeric_limits<T>::digits;
+    T op = x;
+    T res = 0;
+    T one = T(1) << (digits - 2); // second-to-top bit set
+    for (int i = 0; i < digits / 2; i++)
+    {
+        const T t = res + one;
+        const T mask = T(0) - T(op >= t); // all bits set if op >= res + one
+        op -= t & mask;
+        res = (res >> 1) + (one & mask);
+        one >>= 2;
+    }
+    return res;
+}
+
+// Calculate floating-point square root and correct the result by +-1.
+// A float is precise enough for up to 32 bit values, 64 bit values need a double.
+template <typename T>
+T sqrti_8(const T x)
+{
+    using F = typename std::conditional<(std::numeric_limits<T>::digits <= 32), float, double>::type;
+    constexpr T maxRoot = (T(1) << (std::numeric_limits<T>::digits / 2)) - 1;
+    T r = static_cast<T>(sqrt(static_cast<F>(x)));
+    // rounding x to F can make the result overflow r * r
+    r = r > maxRoot ? maxRoot : r;
+    r -= T(T(r * r) > x);
+    r += T(T(x - r * r) > T(2 * r));
+    return r;
+}
+
+template <typename T>
+class SqrtiTestT : public Test<T, T, double>
 {
   public:
-    SqrtiTest(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
-        : Test(
-            "sqrti", inputGenerator,
-            fixupInputRange(inputRange), samplesInRange, &sqrti_reference, &dummyFunc)
+    using typename Test<T, T, double>::input_t;
+    using typename Test<T, T, double>::input_range_t;
+    using typename Test<T, T, double>::input_generator_t;
+    using typename Test<T, T, double>::storage_t;
+
+    SqrtiTestT(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test<T, T, double>(
+            suiteName(), inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &sqrti_reference<T>)
     {
     }
 
     std::vector<Result<input_t, storage_t>> runTests() const
     {
         std::vector<Result<input_t, storage_t>> results;
-        results.push_back(run("#0", "std::sqrt", &sqrti_reference));
-        results.push_back(run("#1", "Optimized binomial theorem", &sqrti_1));
-        results.push_back(run("#2", "Abacus algorithm", &sqrti_2));
-        results.push_back(run("#3", "Crenshaw Embedded 1998", &sqrti_3));
-        results.push_back(run("#4", "Fosler Microchip", &sqrti_4));
-        results.push_back(run("#5", "Tristan Muntsinger", &sqrti_5));
+        results.push_back(this->run("#0", "std::sqrt", &sqrti_0<T>));
+        results.push_back(this->run("#1", "Optimized binomial theorem", &sqrti_1<T>));
+        results.push_back(this->run("#2", "Abacus algorithm", &sqrti_2<T>));
+        results.push_back(this->run("#3", "Crenshaw Embedded 1998", &sqrti_3<T>));
+        results.push_back(this->run("#4", "Fosler Microchip", &sqrti_4<T>));
+        results.push_back(this->run("#5", "Tristan Muntsinger", &sqrti_5<T>));
+        results.push_back(this->run("#6", "clz seed + fixed Newton", &sqrti_6<T>));
+        results.push_back(this->run("#7", "Branchless abacus", &sqrti_7<T>));
+        results.push_back(this->run("#8", std::numeric_limits<T>::digits <= 32 ? "sqrtf + correction" : "sqrt + correction", &sqrti_8<T>));
         return results;
     }
 
   protected:
-    static input_t dummyFunc(const input_t x)
+    static std::string suiteName()
     {
-        return x;
+        constexpr int digits = std::numeric_limits<T>::digits;
+        return digits == 32 ? "sqrti" : "sqrti" + std::to_string(digits);
     }
 
     static input_range_t fixupInputRange(const input_range_t& range)
@@ -180,4 +274,8 @@ class SqrtiTest : public Test<uint32_t, uint32_t, double>
         result.second = result.second > std::numeric_limits<input_t>::max() ? std::numeric_limits<input_t>::max() : result.second;
         return result;
     }
-};
\ No newline at end of file
+};
+
+using Sqrti16Test = SqrtiTestT<uint16_t>;
+using SqrtiTest = SqrtiTestT<uint32_t>;
+using Sqrti64Test = SqrtiTestT<uint64_t>;
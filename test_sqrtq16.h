@@ -0,0 +1,116 @@
+#pragma once
+
+// Square root of signed Q16.16 fixed-point numbers.
+// The integer algorithms are from test_sqrti.h, extended to produce the fractional bits.
+// See: "Jack W. Crenshaw - Math Toolkit for Real-Time Development", chapter 4
+// See: https://github.com/chmike/fpsqrt/blob/master/fpsqrt.c
+
+// All functions here assume positive input values.
+// Inputs and outputs are raw Q16.16 values, so absolute errors are in LSBs (1 / 65536).
+
+#include "test.h"
+#include "test_sqrti.h"
+#include <cstdint>
+#include <math.h>
+#include <vector>
+
+// Calculate the reference value for comparison in LSBs.
+// sqrt(x / 2^16) * 2^16 == sqrt(x * 2^16)
+long double sqrtq16_reference(const long double x)
+{
+    return sqrtl(x * 65536.0L);
+}
+
+// Convert to float, call sqrtf and convert back with rounding.
+int32_t sqrtq16_0(const int32_t x)
+{
+    return static_cast<int32_t>(sqrtf(x * (1.0F / 65536.0F)) * 65536.0F + 0.5F);
+}
+
+// Jack W. Crenshaw's integer square root (see sqrti_3) running 8 more iterations
+// to get 8 fractional bits in the root (16 in the result).
+int32_t sqrtq16_1(const int32_t x)
+{
+    uint32_t v = x;
+    uint32_t rem = 0;
+    uint32_t root = 0;
+    for (int i = 24; i > 0; i--)
+    {
+        root <<= 1;
+        rem = (rem << 2) | (v >> (32 - 2));
+        v <<= 2;
+        if (root < rem)
+        {
+            rem -= root | 1;
+            root += 2;
+        }
+    }
+    return root >> 1;
+}
+
+// Christophe Meessen's fixed-point square root. Only uses 32 bit operations.
+// Note that the remainder overflows for x >= 2^30 (16384.0), so the result is only valid below that.
+// See: https://github.com/chmike/fpsqrt/blob/master/fpsqrt.c
+int32_t sqrtq16_2(const int32_t x)
+{
+    uint32_t t, q, b, r;
+    r = x;
+    b = 0x40000000;
+    q = 0;
+    while (b > 0x40)
+    {
+        t = q + b;
+        if (r >= t)
+        {
+            r -= t;
+            q = t + b; // equivalent to q += 2*b
+        }
+        r <<= 1;
+        b >>= 1;
+    }
+    q >>= 8;
+    return q;
+}
+
+// 64 bit integer square root of x * 2^16 using clz seed + fixed Newton iterations (see sqrti_6).
+int32_t sqrtq16_3(const int32_t x)
+{
+    return static_cast<int32_t>(sqrti_6<uint64_t>(static_cast<uint64_t>(x) << 16));
+}
+
+// 64 bit integer square root of x * 2^16 using double sqrt + correction (see sqrti_8).
+int32_t sqrtq16_4(const int32_t x)
+{
+    return static_cast<int32_t>(sqrti_8<uint64_t>(static_cast<uint64_t>(x) << 16));
+}
+
+class SqrtQ16Test : public Test<int32_t, int32_t, double>
+{
+  public:
+    SqrtQ16Test(input_generator_t inputGenerator, const input_range_t& inputRange, uint64_t samplesInRange)
+        : Test(
+            "sqrt Q16.16", inputGenerator,
+            fixupInputRange(inputRange), samplesInRange, &sqrtq16_reference)
+    {
+    }
+
+    std::vector<Result<input_t, storage_t>> runTests() const
+    {
+        std::vector<Result<input_t, storage_t>> results;
+        results.push_back(run("#0", "float + std::sqrtf", &sqrtq16_0));
+        results.push_back(run("#1", "Crenshaw 24 iterations", &sqrtq16_1));
+        results.push_back(run("#2", "Christophe Meessen fpsqrt", &sqrtq16_2));
+        results.push_back(run("#3", "64 bit clz seed + fixed Newton", &sqrtq16_3));
+        results.push_back(run("#4", "64 bit sqrt + correction", &sqrtq16_4));
+        return results;
+    }
+
+  protected:
+    static input_range_t fixupInputRange(const input_range_t& range)
+    {
+        input_range_t result;
+        result.first = range.first < 0 ? 0 : range.first;
+        result.second = range.second < 0 ? 0 : range.second;
+        return result;
+    }
+};
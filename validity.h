@@ -0,0 +1,143 @@
+#pragma once
+
+// Find the domain of validity of an approximation, i.e. the longest interval of input values where its error stays below a threshold.
+// The whole floating-point domain including denormals and negative values is split into binades [2^n, 2^(n+1)).
+// A fixed number of values per binade is checked in parallel, then the longest run of valid binades is extended into
+// the neighbouring binades by bisecting between the last valid and the first invalid value. This assumes the validity
+// only changes once between neighbouring samples, so narrow invalid spikes inside a binade can be missed.
+// See: https://en.wikipedia.org/wiki/Bisection_method
+
+#include "bitops.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// number of values checked in every binade
+static constexpr uint64_t VALIDITY_SAMPLES_PER_BINADE = 64;
+
+/// @brief Find the longest interval of float or double values where all checked values are valid.
+/// @param check Function of type std::vector<char>(const std::vector<T>& values) that returns true for every valid value.
+/// It is called from multiple threads at the same time.
+/// @param range Receives the first and last valid value of the interval.
+/// @return false if no valid value was found.
+template <typename T, typename Check>
+bool findValidRange(Check check, std::pair<T, T>& range)
+{
+    static_assert(std::is_floating_point<T>::value && (sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t)), "Only float and double supported");
+    using U = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    constexpr int mantissaBits = std::numeric_limits<T>::digits - 1;
+    constexpr U maxExponent = (U(1) << (sizeof(U) * 8 - 1 - mantissaBits)) - 2;
+    constexpr U signBit = U(1) << (sizeof(U) * 8 - 1);
+    // binades as intervals of totalOrderBits() keys, sorted by value. All finite values are covered without gaps
+    std::vector<std::pair<U, U>> binades;
+    for (U e = maxExponent + 1; e-- > 0;)
+    {
+        // negative values: larger magnitudes have smaller keys. exponent 0 are the denormals
+        const U first = e == 0 ? U(1) : U(e << mantissaBits);
+        const U last = U(((e + 1) << mantissaBits) - 1);
+        binades.push_back({U(~(last | signBit)), U(~(first | signBit))});
+    }
+    // -0 and 0
+    binades.push_back({U(~signBit), signBit});
+    for (U e = 0; e <= maxExponent; ++e)
+    {
+        const U first = e == 0 ? U(1) : U(e << mantissaBits);
+        const U last = U(((e + 1) << mantissaBits) - 1);
+        binades.push_back({U(first | signBit), U(last | signBit)});
+    }
+    // check sample values of all binades in parallel
+    std::vector<std::vector<std::pair<U, char>>> samples(binades.size());
+    std::vector<char> binadeValid(binades.size(), 0);
+    std::atomic<std::size_t> nextBinade(0);
+    auto worker = [&]()
+    {
+        for (std::size_t b = nextBinade++; b < binades.size(); b = nextBinade++)
+        {
+            const U first = binades[b].first;
+            const U count = binades[b].second - first;
+            const U steps = std::min(count, U(VALIDITY_SAMPLES_PER_BINADE - 1));
+            std::vector<T> values;
+            for (U i = 0; i <= steps; ++i)
+            {
+                values.push_back(fromTotalOrderBits<T>(U(first + (steps > 0 ? (count / steps) * i + ((count % steps) * i) / steps : 0))));
+            }
+            const auto valid = check(values);
+            binadeValid[b] = std::all_of(valid.cbegin(), valid.cend(), [](char v)
+                                         { return v != 0; });
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                samples[b].push_back({totalOrderBits(values[i]), valid[i]});
+            }
+        }
+    };
+    std::vector<std::thread> threads(std::max(1U, std::thread::hardware_concurrency()));
+    for (auto& t : threads)
+    {
+        t = std::thread(worker);
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    // find the longest run of valid binades. prefer larger values if there are multiple, e.g. for odd functions
+    std::size_t bestFirst = 0;
+    std::size_t bestCount = 0;
+    for (std::size_t b = 0; b < binades.size();)
+    {
+        std::size_t count = 0;
+        while (b + count < binades.size() && binadeValid[b + count])
+        {
+            ++count;
+        }
+        if (count >= bestCount && count > 0)
+        {
+            bestFirst = b;
+            bestCount = count;
+        }
+        b += count + 1;
+    }
+    if (bestCount == 0)
+    {
+        return false;
+    }
+    // check a single value
+    auto isValid = [&check](U key)
+    {
+        return check(std::vector<T>{fromTotalOrderBits<T>(key)}).front() != 0;
+    };
+    // bisect between a valid and an invalid key and return the last valid key on the side of the valid key
+    auto bisect = [&isValid](U valid, U invalid)
+    {
+        while ((valid < invalid ? invalid - valid : valid - invalid) > 1)
+        {
+            const U middle = valid < invalid ? U(valid + (invalid - valid) / 2) : U(invalid + (valid - invalid) / 2);
+            (isValid(middle) ? valid : invalid) = middle;
+        }
+        return valid;
+    };
+    U lastKey = binades[bestFirst + bestCount - 1].second;
+    if (bestFirst + bestCount < binades.size())
+    {
+        // the next binade has an invalid sample. start from the last valid sample before it
+        const auto& next = samples[bestFirst + bestCount];
+        auto invalidIt = std::find_if(next.cbegin(), next.cend(), [](const auto& s)
+                                      { return s.second == 0; });
+        lastKey = bisect(invalidIt == next.cbegin() ? lastKey : std::prev(invalidIt)->first, invalidIt->first);
+    }
+    U firstKey = binades[bestFirst].first;
+    if (bestFirst > 0)
+    {
+        // the previous binade has an invalid sample. start from the first valid sample after it
+        const auto& previous = samples[bestFirst - 1];
+        auto invalidIt = std::find_if(previous.crbegin(), previous.crend(), [](const auto& s)
+                                      { return s.second == 0; });
+        firstKey = bisect(invalidIt == previous.crbegin() ? firstKey : std::prev(invalidIt)->first, invalidIt->first);
+    }
+    range = {fromTotalOrderBits<T>(firstKey), fromTotalOrderBits<T>(lastKey)};
+    return true;
+}